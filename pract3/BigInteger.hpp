@@ -15,16 +15,58 @@ private:
     // Indica si el número es negativo.
     bool isNegative;
 
+    // Suma (o resta si negateOther es true) sin copiar other para cambiarle el signo
+    BigInteger addSigned(const BigInteger& other, bool negateOther) const {
+        bool otherNegative = (other.isNegative != negateOther) && !other.number.isZero();
+        // Si ambos números tienen el mismo signo, se suma y se conserva el signo.
+        if(isNegative == otherNegative) {
+            BigInteger res(number + other.number);
+            res.isNegative = isNegative && !res.number.isZero();
+            return res;
+        }
+        // Si los signos son distintos, se efectúa la resta y se asigna el signo del mayor valor absoluto.
+        // Si los valores absolutos coinciden el resultado es 0, que no lleva signo.
+        int cmp = number.compare(other.number);
+        if(cmp == 0)
+            return BigInteger();
+        BigInteger res(cmp > 0 ? number - other.number : other.number - number);
+        res.isNegative = (cmp > 0) ? isNegative : otherNegative;
+        return res;
+    }
+
+    // Versión en el sitio de addSigned: reutiliza el buffer de number siempre que |*this| >= |other|
+    BigInteger& addSignedInPlace(const BigInteger& other, bool negateOther) {
+        bool otherNegative = (other.isNegative != negateOther) && !other.number.isZero();
+        if(isNegative == otherNegative) {
+            number += other.number;
+        } else if(number.compare(other.number) >= 0) {
+            number -= other.number;
+        } else {
+            number = other.number - number;
+            isNegative = otherNegative;
+        }
+        if(number.isZero())
+            isNegative = false;
+        return *this;
+    }
+
 public:
     // Constructor a partir de un entero.
+    // El valor se pasa directamente a limbs, sin construir ni analizar una cadena
     BigInteger(int n = 0)
-        : isNegative(n < 0),
-          number((n < 0) ? std::to_string(-n).c_str() : std::to_string(n).c_str()) {}
+        : number(BigUnsigned<Base>::fromWord((n < 0) ? 0ULL - n : n)),
+          isNegative(n < 0) {}
 
     // Constructor a partir de un BigUnsigned (número no negativo).
     BigInteger(const BigUnsigned<Base>& bigUnsigned)
         : number(bigUnsigned), isNegative(false) {}
 
+    // Conversión desde un BigInteger de otra base: se convierte el valor absoluto y se
+    // conserva el signo
+    template <unsigned char Other>
+    explicit BigInteger(const BigInteger<Other>& other)
+        : number(other.number), isNegative(other.isNegative) {}
+
     // Constructor a partir de una cadena con signo opcional.
     BigInteger(const char* str) {
         std::string s(str);
@@ -38,76 +80,117 @@ public:
     }
 
     // Operador suma
-    BigInteger operator+(const BigInteger& other) const {
-        // Si ambos números tienen el mismo signo, se suma y se conserva el signo.
-        if(isNegative == other.isNegative) {
-            BigInteger res(number + other.number);
-            res.isNegative = isNegative;
-            return res;
-        } else {
-            // Si los signos son distintos, se efectúa la resta y se asigna el signo del mayor valor absoluto.
-            if(number.to_decimal() >= other.number.to_decimal()){
-                BigInteger res(number - other.number);
-                res.isNegative = isNegative;
-                return res;
-            } else {
-                BigInteger res(other.number - number);
-                res.isNegative = other.isNegative;
-                return res;
-            }
-        }
+    BigInteger operator+(const BigInteger& other) const & {
+        return addSigned(other, false);
+    }
+
+    // Si el operando izquierdo es un temporal se suma sobre su propio buffer
+    BigInteger operator+(const BigInteger& other) && {
+        return std::move(addSignedInPlace(other, false));
     }
 
     // Operador resta
     // definido en términos de suma, invirtiendo el signo del segundo operando.
-    BigInteger operator-(const BigInteger& other) const {
-        BigInteger negOther = other;
-        negOther.isNegative = !negOther.isNegative;
-        return (*this) + negOther;
+    BigInteger operator-(const BigInteger& other) const & {
+        return addSigned(other, true);
+    }
+
+    BigInteger operator-(const BigInteger& other) && {
+        return std::move(addSignedInPlace(other, true));
     }
 
     // Operador multiplicación
+    // Si other es el propio objeto, BigUnsigned detecta el cuadrado
     BigInteger operator*(const BigInteger& other) const {
         BigInteger res(number * other.number);
-        // El resultado es negativo si solo uno de los operandos es negativo.
-        res.isNegative = (isNegative != other.isNegative);
+        // El resultado es negativo si solo uno de los operandos es negativo (el 0 no lleva signo).
+        res.isNegative = (isNegative != other.isNegative) && !res.number.isZero();
         return res;
     }
 
+    // Operadores compuestos: la suma y la resta trabajan sobre el propio número
+    BigInteger& operator+=(const BigInteger& other) {
+        return addSignedInPlace(other, false);
+    }
+
+    BigInteger& operator-=(const BigInteger& other) {
+        return addSignedInPlace(other, true);
+    }
+
+    BigInteger& operator*=(const BigInteger& other) {
+        bool negative = (isNegative != other.isNegative);
+        number *= other.number;
+        isNegative = negative && !number.isZero();
+        return *this;
+    }
+
+    BigInteger& operator/=(const BigInteger& other) {
+        bool negative = (isNegative != other.isNegative);
+        number /= other.number;
+        isNegative = negative && !number.isZero();
+        return *this;
+    }
+
+    // El resto conserva el signo del dividendo, como en operator%
+    BigInteger& operator%=(const BigInteger& other) {
+        number %= other.number;
+        isNegative = isNegative && !number.isZero();
+        return *this;
+    }
+
     // Operador división 
     // asumo que BigUnsigned tiene operator/ implementado
     BigInteger operator/(const BigInteger& other) const {
         BigInteger res(number / other.number);
-        res.isNegative = (isNegative != other.isNegative);
+        res.isNegative = (isNegative != other.isNegative) && !res.number.isZero();
         return res;
     }
 
+    // Operador módulo
+    // El resto tiene el signo del dividendo, coherente con la división truncada de operator/
+    BigInteger operator%(const BigInteger& other) const {
+        BigInteger res(number % other.number);
+        res.isNegative = isNegative && !res.number.isZero();
+        return res;
+    }
+
+    // Potencia con exponente no negativo
+    // El resultado es negativo si la base lo es y el exponente es impar
+    BigInteger pow(const BigUnsigned<Base>& exponent) const {
+        BigInteger res(number.pow(exponent));
+        res.isNegative = isNegative && exponent.isOdd() && !res.number.isZero();
+        return res;
+    }
+
+    // Comparación con signo: devuelve un valor negativo, 0 o positivo si *this es menor, igual
+    // o mayor que other. Se comparan los signos y, si coinciden, los valores absolutos con
+    // BigUnsigned::compare (el 0 cuenta como no negativo aunque se haya leído como "-0")
+    int compare(const BigInteger& other) const {
+        bool negative = isNegative && !number.isZero();
+        bool otherNegative = other.isNegative && !other.number.isZero();
+        if(negative != otherNegative)
+            return negative ? -1 : 1;
+        int cmp = number.compare(other.number);
+        return negative ? -cmp : cmp;
+    }
+
     // Método para obtener la parte entera en decimal
     unsigned long long to_decimal() const {
         return number.to_decimal();
     }
 
-    // Métodos virtuales de BigNumber utilizando conversión.
-    virtual BigNumber<Base>& add(const BigNumber<Base>& other) const {
-        // Se utiliza el operador de conversión a BigInteger.
-        BigInteger otherConv = other;
-        BigInteger* res = new BigInteger((*this) + otherConv);
-        return *res;
-    }
-    virtual BigNumber<Base>& subtract(const BigNumber<Base>& other) const {
-        BigInteger otherConv = other;
-        BigInteger* res = new BigInteger((*this) - otherConv);
-        return *res;
+    // Métodos virtuales de BigNumber
+    // La suma, resta, multiplicación, división y módulo los resuelve la tabla de BigNumber
+    virtual typename BigNumber<Base>::Kind kind() const {
+        return BigNumber<Base>::INTEGER;
     }
-    virtual BigNumber<Base>& multiply(const BigNumber<Base>& other) const {
-        BigInteger otherConv = other;
-        BigInteger* res = new BigInteger((*this) * otherConv);
-        return *res;
-    }
-    virtual BigNumber<Base>& divide(const BigNumber<Base>& other) const {
-        BigInteger otherConv = other;
-        BigInteger* res = new BigInteger((*this) / otherConv);
-        return *res;
+    virtual std::unique_ptr<BigNumber<Base>> power(const BigNumber<Base>& other) const {
+        bool negative;
+        BigUnsigned<Base> exponent = BigNumber<Base>::exponentOf(other, negative);
+        // Un exponente negativo daría un resultado no entero
+        if(negative)
+            throw BigNumberException();
+        return BigNumber<Base>::makeOwned(pow(exponent));
     }
 
     // Operadores de conversión
@@ -135,6 +218,13 @@ public:
         return in;
     }
 
+    // BigNumber necesita acceder al signo y al valor absoluto para extraer exponentes
+    friend class BigNumber<Base>;
+    // BigRational necesita el valor absoluto y el signo del numerador
+    friend class BigRational<Base>;
+    // La conversión entre bases lee el valor absoluto y el signo de las otras instancias
+    template <unsigned char> friend class BigInteger;
+
     // Sobrecarga del operador << para imprimir BigInteger
     template <unsigned char B>
     friend std::ostream& operator<<(std::ostream& out, const BigInteger<B>& num);
@@ -4,6 +4,9 @@
 #include <iostream>
 #include <exception>
 #include <string>
+#include <memory>
+#include <utility>
+#include <type_traits>
 
 // Daniel Palenzuela Álvarez alu0101140469
 
@@ -20,15 +23,37 @@ class BigRational;
 template <unsigned char Base>
 class BigNumber {
 public:
+    // Etiqueta del tipo concreto, ordenada de menos a más general
+    enum Kind { UNSIGNED = 0, INTEGER = 1, RATIONAL = 2 };
+
     // Destructor virtual para permitir eliminación polimórfica
     virtual ~BigNumber() {}
 
-    // Métodos aritméticos virtuales puros
-    // Cada clase derivada debe implementar estos métodos para sumar, restar, multiplicar y dividir
-    virtual BigNumber<Base>& add(const BigNumber<Base>&) const = 0;
-    virtual BigNumber<Base>& subtract(const BigNumber<Base>&) const = 0;
-    virtual BigNumber<Base>& multiply(const BigNumber<Base>&) const = 0;
-    virtual BigNumber<Base>& divide(const BigNumber<Base>&) const = 0;
+    // Tipo concreto del objeto
+    virtual Kind kind() const = 0;
+
+    // Métodos aritméticos
+    // Ambos operandos se promueven al tipo más general de los dos (BigUnsigned < BigInteger <
+    // BigRational) y se opera con los operadores de ese tipo. El resultado es un objeto nuevo
+    // cuya propiedad pasa al llamador a través del unique_ptr, que lo libera cuando deja de usarse
+    std::unique_ptr<BigNumber<Base>> add(const BigNumber<Base>& other) const {
+        return dispatch<AddOp>(other);
+    }
+    std::unique_ptr<BigNumber<Base>> subtract(const BigNumber<Base>& other) const {
+        return dispatch<SubtractOp>(other);
+    }
+    std::unique_ptr<BigNumber<Base>> multiply(const BigNumber<Base>& other) const {
+        return dispatch<MultiplyOp>(other);
+    }
+    std::unique_ptr<BigNumber<Base>> divide(const BigNumber<Base>& other) const {
+        return dispatch<DivideOp>(other);
+    }
+    std::unique_ptr<BigNumber<Base>> modulo(const BigNumber<Base>& other) const {
+        return dispatch<ModuloOp>(other);
+    }
+    // Potencia con el operando como exponente (debe ser un valor entero)
+    // El resultado conserva el tipo de la base, por lo que la implementa cada clase derivada
+    virtual std::unique_ptr<BigNumber<Base>> power(const BigNumber<Base>&) const = 0;
 
     // Operadores de conversión virtuales puros
     // Permiten convertir el objeto a alguno de los tipos concretos (BigUnsigned, BigInteger o BigRational)
@@ -48,9 +73,73 @@ public:
         return num.read(in);
     }
 
+    // Copia del número expresada en la base Out, del mismo tipo concreto que este
+    // Entre bases potencia de dos se reagrupan los bits; en el resto de casos se usa la
+    // conversión por divide y vencerás de BigUnsigned
+    template <unsigned char Out>
+    std::unique_ptr<BigNumber<Out>> toBase() const;
+
     // Crea dinámicamente el objeto concreto a partir de una cadena
     // La cadena debe terminar con un sufijo (u para BigUnsigned, i para BigInteger, r para BigRational)
-    static BigNumber<Base>* create(const char* str);
+    static std::unique_ptr<BigNumber<Base>> create(const char* str);
+
+protected:
+    // Mueve (o copia) value a un objeto dinámico de su mismo tipo, propiedad del puntero devuelto
+    template <typename T>
+    static std::unique_ptr<BigNumber<Base>> makeOwned(T&& value) {
+        typedef typename std::decay<T>::type Concrete;
+        return std::unique_ptr<BigNumber<Base>>(new Concrete(std::forward<T>(value)));
+    }
+
+    // Extrae el exponente entero de un BigNumber para power: devuelve su valor absoluto y
+    // guarda su signo en negative. Lanza excepción si es un racional no entero
+    static BigUnsigned<Base> exponentOf(const BigNumber<Base>& exponent, bool& negative);
+
+private:
+    // Tipo concreto asociado a cada etiqueta
+    template <int K>
+    using KindType = typename std::conditional<K == UNSIGNED, BigUnsigned<Base>,
+                     typename std::conditional<K == INTEGER, BigInteger<Base>,
+                                               BigRational<Base>>::type>::type;
+
+    // Operaciones del dispatch, aplicadas sobre dos operandos del tipo ya promovido
+    struct AddOp { template <class T> static T apply(const T& x, const T& y) { return x + y; } };
+    struct SubtractOp { template <class T> static T apply(const T& x, const T& y) { return x - y; } };
+    struct MultiplyOp { template <class T> static T apply(const T& x, const T& y) { return x * y; } };
+    struct DivideOp { template <class T> static T apply(const T& x, const T& y) { return x / y; } };
+    struct ModuloOp { template <class T> static T apply(const T& x, const T& y) { return x % y; } };
+
+    // Promoción de un operando al tipo P (el segundo parámetro solo selecciona la sobrecarga)
+    // Si el operando ya es de tipo P se devuelve una referencia a él, sin copiarlo
+    static const BigUnsigned<Base>& promote(const BigUnsigned<Base>& x, BigUnsigned<Base>*) { return x; }
+    static const BigInteger<Base>& promote(const BigInteger<Base>& x, BigInteger<Base>*) { return x; }
+    static const BigRational<Base>& promote(const BigRational<Base>& x, BigRational<Base>*) { return x; }
+    static BigInteger<Base> promote(const BigUnsigned<Base>& x, BigInteger<Base>*);
+    static BigRational<Base> promote(const BigUnsigned<Base>& x, BigRational<Base>*);
+    static BigRational<Base> promote(const BigInteger<Base>& x, BigRational<Base>*);
+
+    // Caso (L, R) de la tabla: los static_cast son seguros porque la etiqueta ya fija el tipo
+    // Si ambos operandos son el mismo objeto llegan como la misma referencia y los operadores
+    // de multiplicación siguen detectando el cuadrado
+    template <class Op, int L, int R>
+    static std::unique_ptr<BigNumber<Base>> handle(const BigNumber<Base>& a, const BigNumber<Base>& b) {
+        typedef KindType<(L > R) ? L : R> Promoted;
+        auto&& x = promote(static_cast<const KindType<L>&>(a), (Promoted*)nullptr);
+        auto&& y = promote(static_cast<const KindType<R>&>(b), (Promoted*)nullptr);
+        return makeOwned(Op::template apply<Promoted>(x, y));
+    }
+
+    // Tabla 3x3 generada en compilación, indexada por las etiquetas de ambos operandos
+    template <class Op>
+    std::unique_ptr<BigNumber<Base>> dispatch(const BigNumber<Base>& other) const {
+        typedef std::unique_ptr<BigNumber<Base>> (*Handler)(const BigNumber<Base>&, const BigNumber<Base>&);
+        static const Handler table[3][3] = {
+            { &handle<Op, UNSIGNED, UNSIGNED>, &handle<Op, UNSIGNED, INTEGER>, &handle<Op, UNSIGNED, RATIONAL> },
+            { &handle<Op, INTEGER, UNSIGNED>,  &handle<Op, INTEGER, INTEGER>,  &handle<Op, INTEGER, RATIONAL> },
+            { &handle<Op, RATIONAL, UNSIGNED>, &handle<Op, RATIONAL, INTEGER>, &handle<Op, RATIONAL, RATIONAL> }
+        };
+        return table[kind()][other.kind()](*this, other);
+    }
 };
 
 // Definición de excepciones
@@ -86,7 +175,7 @@ public:
 // Implementación del método de fábrica create
 // Analiza la cadena de entrada, extrae el sufijo, y crea el objeto concreto
 template <unsigned char Base>
-BigNumber<Base>* BigNumber<Base>::create(const char* str) {
+std::unique_ptr<BigNumber<Base>> BigNumber<Base>::create(const char* str) {
     std::string s(str);
     if(s.empty())
         return nullptr;
@@ -94,9 +183,9 @@ BigNumber<Base>* BigNumber<Base>::create(const char* str) {
     char type = s.back();
     s.pop_back(); // Se elimina el sufijo de la cadena
     if(type == 'u') {
-        return new BigUnsigned<Base>(s.c_str());
+        return makeOwned(BigUnsigned<Base>(s.c_str()));
     } else if(type == 'i') {
-        return new BigInteger<Base>(s.c_str());
+        return makeOwned(BigInteger<Base>(s.c_str()));
     } else if(type == 'r') {
         // Para BigRational se espera el formato "numerador/denominador"
         size_t pos = s.find('/');
@@ -106,10 +195,67 @@ BigNumber<Base>* BigNumber<Base>::create(const char* str) {
         std::string den = s.substr(pos+1);
         BigInteger<Base> n(num.c_str());
         BigUnsigned<Base> d(den.c_str());
-        return new BigRational<Base>(n, d);
+        return makeOwned(BigRational<Base>(n, d));
     } else {
         throw BigNumberException();
     }
 }
 
+// Implementación de exponentOf
+// Un BigRational solo es un exponente válido si su denominador es 1
+template <unsigned char Base>
+BigUnsigned<Base> BigNumber<Base>::exponentOf(const BigNumber<Base>& exponent, bool& negative) {
+    negative = false;
+    switch(exponent.kind()) {
+        case UNSIGNED:
+            return static_cast<const BigUnsigned<Base>&>(exponent);
+        case INTEGER: {
+            const BigInteger<Base>& value = static_cast<const BigInteger<Base>&>(exponent);
+            negative = value.isNegative && !value.number.isZero();
+            return value.number;
+        }
+        default: {
+            const BigRational<Base>& value = static_cast<const BigRational<Base>&>(exponent);
+            if(!(value.denominator == BigUnsigned<Base>("1")))
+                throw BigNumberException();
+            negative = value.numerator.isNegative && !value.numerator.number.isZero();
+            return value.numerator.number;
+        }
+    }
+}
+
+// Implementación de toBase
+// La etiqueta fija el tipo concreto, así que el static_cast es seguro
+template <unsigned char Base>
+template <unsigned char Out>
+std::unique_ptr<BigNumber<Out>> BigNumber<Base>::toBase() const {
+    switch(kind()) {
+        case UNSIGNED:
+            return std::unique_ptr<BigNumber<Out>>(
+                new BigUnsigned<Out>(static_cast<const BigUnsigned<Base>&>(*this)));
+        case INTEGER:
+            return std::unique_ptr<BigNumber<Out>>(
+                new BigInteger<Out>(static_cast<const BigInteger<Base>&>(*this)));
+        default:
+            return std::unique_ptr<BigNumber<Out>>(
+                new BigRational<Out>(static_cast<const BigRational<Base>&>(*this)));
+    }
+}
+
+// Implementación de las promociones del dispatch
+// Se construye directamente el tipo destino; un entero pasa a ser la fracción n/1, que ya
+// está reducida
+template <unsigned char Base>
+BigInteger<Base> BigNumber<Base>::promote(const BigUnsigned<Base>& x, BigInteger<Base>*) {
+    return BigInteger<Base>(x);
+}
+template <unsigned char Base>
+BigRational<Base> BigNumber<Base>::promote(const BigUnsigned<Base>& x, BigRational<Base>*) {
+    return BigRational<Base>(BigInteger<Base>(x), BigUnsigned<Base>::fromWord(1), true);
+}
+template <unsigned char Base>
+BigRational<Base> BigNumber<Base>::promote(const BigInteger<Base>& x, BigRational<Base>*) {
+    return BigRational<Base>(x, BigUnsigned<Base>::fromWord(1), true);
+}
+
 #endif
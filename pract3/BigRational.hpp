@@ -14,58 +14,179 @@ private:
     // Denominador de tipo BigUnsigned (siempre positivo)
     BigUnsigned<Base> denominator;
 
+    // Reduce la fracción a su mínima expresión dividiendo entre mcd(numerador, denominador)
+    // Como el mcd divide a ambos, se usa la división exacta
+    // Así el tamaño de numerador y denominador es proporcional al del valor real y no crece
+    // con cada operación. El 0 se representa siempre como 0/1
+    void normalize() {
+        if(denominator.isZero())
+            throw BigNumberDivisionByZero();
+        BigUnsigned<Base> one("1");
+        if(numerator.number.isZero()) {
+            numerator.isNegative = false;
+            denominator = one;
+            return;
+        }
+        BigUnsigned<Base> g = numerator.number.gcd(denominator);
+        if(!(g == one)) {
+            numerator.number = numerator.number.divexact(g);
+            denominator = denominator.divexact(g);
+        }
+    }
+
+    // Constructor para fracciones que ya se sabe que están reducidas (no calcula el mcd)
+    BigRational(const BigInteger<Base>& num, const BigUnsigned<Base>& den, bool)
+        : numerator(num), denominator(den) {}
+
+    // Igual que el anterior, pero se queda con los buffers de los temporales
+    BigRational(BigInteger<Base>&& num, BigUnsigned<Base>&& den, bool)
+        : numerator(std::move(num)), denominator(std::move(den)) {}
+
+    // Suma (o resta si negateOther es true) con el algoritmo de Henrici
+    // Con g = mcd(b, d): a/b + c/d = (a*(d/g) + c*(b/g)) / ((b/g)*d), y el único factor común
+    // que puede quedar entre ese numerador t y el denominador divide a g, así que basta con
+    // g2 = mcd(t, g), mucho más pequeño que el mcd del resultado completo
+    // El signo de other se aplica al sumar los productos, sin copiar su numerador
+    BigRational addHenrici(const BigRational& other, bool negateOther) const {
+        BigUnsigned<Base> one("1");
+        BigUnsigned<Base> g = denominator.gcd(other.denominator);
+        if(g == one) {
+            BigInteger<Base> t = numerator * BigInteger<Base>(other.denominator);
+            t.addSignedInPlace(other.numerator * BigInteger<Base>(denominator), negateOther);
+            return BigRational(std::move(t), denominator * other.denominator, true);
+        }
+        BigUnsigned<Base> bg = denominator.divexact(g);
+        BigInteger<Base> t = numerator * BigInteger<Base>(other.denominator.divexact(g));
+        t.addSignedInPlace(other.numerator * BigInteger<Base>(bg), negateOther);
+        if(t.number.isZero())
+            return BigRational();
+        BigUnsigned<Base> g2 = t.number.gcd(g);
+        if(!(g2 == one))
+            t.number = t.number.divexact(g2);
+        return BigRational(std::move(t), bg * other.denominator.divexact(g2), true);
+    }
+
 public:
     // Constructor por defecto: representa el número 0/1
+    // La fracción se guarda siempre reducida
     BigRational(const BigInteger<Base>& num = 0, const BigUnsigned<Base>& den = BigUnsigned<Base>("1"))
-        : numerator(num), denominator(den) {}
+        : numerator(num), denominator(den) {
+        normalize();
+    }
+
+    // Conversión desde un BigRational de otra base
+    // Cambiar de base no altera el valor, así que la fracción sigue reducida
+    template <unsigned char Other>
+    explicit BigRational(const BigRational<Other>& other)
+        : numerator(other.numerator), denominator(other.denominator) {}
 
     // Operador suma para racionales
-    // (a/b) + (c/d) = (a*d + c*b) / (b*d)
+    // (a/b) + (c/d) = (a*d + c*b) / (b*d), calculado con el algoritmo de Henrici
     BigRational operator+(const BigRational& other) const {
-        // Se convierten los denominadores a BigInteger para la operación
-        const BigInteger<Base> temp1(other.denominator);
-        const BigInteger<Base> temp2(denominator);
-        BigInteger<Base> newNum = numerator * temp1 + other.numerator * temp2;
-        BigUnsigned<Base> newDen = denominator * other.denominator;
-        return BigRational(newNum, newDen);
+        return addHenrici(other, false);
     }
 
     // Operador resta
     BigRational operator-(const BigRational& other) const {
-        const BigInteger<Base> temp1(other.denominator);
-        const BigInteger<Base> temp2(denominator);
-        BigInteger<Base> newNum = numerator * temp1 - other.numerator * temp2;
-        BigUnsigned<Base> newDen = denominator * other.denominator;
-        return BigRational(newNum, newDen);
+        return addHenrici(other, true);
     }
 
     // Operador multiplicación
+    // (a/b) * (c/d) = ((a/g1)*(c/g2)) / ((b/g2)*(d/g1)) con g1 = mcd(a, d) y g2 = mcd(c, b)
+    // Al simplificar antes de multiplicar, los productos ya salen reducidos y son más pequeños
+    // Los operandos se usan por referencia y solo se construye la versión reducida de una
+    // pareja de componentes cuando su mcd no es 1, que es el caso menos habitual
     BigRational operator*(const BigRational& other) const {
-        BigInteger<Base> newNum = numerator * other.numerator;
-        BigUnsigned<Base> newDen = denominator * other.denominator;
-        return BigRational(newNum, newDen);
+        // El cuadrado de una fracción reducida ya está reducido
+        if(this == &other)
+            return BigRational(numerator * numerator, denominator * denominator, true);
+        BigUnsigned<Base> one("1");
+        const BigInteger<Base>* a = &numerator;
+        const BigInteger<Base>* c = &other.numerator;
+        const BigUnsigned<Base>* b = &denominator;
+        const BigUnsigned<Base>* d = &other.denominator;
+        BigInteger<Base> aReduced, cReduced;
+        BigUnsigned<Base> bReduced, dReduced;
+        BigUnsigned<Base> g1 = numerator.number.gcd(other.denominator);
+        if(!(g1 == one)) {
+            aReduced.number = numerator.number.divexact(g1);
+            aReduced.isNegative = numerator.isNegative;
+            dReduced = other.denominator.divexact(g1);
+            a = &aReduced;
+            d = &dReduced;
+        }
+        BigUnsigned<Base> g2 = other.numerator.number.gcd(denominator);
+        if(!(g2 == one)) {
+            cReduced.number = other.numerator.number.divexact(g2);
+            cReduced.isNegative = other.numerator.isNegative;
+            bReduced = denominator.divexact(g2);
+            c = &cReduced;
+            b = &bReduced;
+        }
+        BigInteger<Base> newNum = (*a) * (*c);
+        if(newNum.number.isZero())
+            return BigRational();
+        return BigRational(std::move(newNum), (*b) * (*d), true);
     }
 
-    // Para la división se lanza excepción
-    virtual BigNumber<Base>& divide(const BigNumber<Base>& other) const {
-        throw BigNumberException();
+    // Potencia con exponente entero
+    // (a/b)^e = a^e / b^e y, si el exponente es negativo, se invierte la fracción
+    BigRational pow(const BigUnsigned<Base>& exponent, bool negative = false) const {
+        // Las potencias de una fracción reducida siguen reducidas
+        BigRational result(numerator.pow(exponent), denominator.pow(exponent), true);
+        return negative ? result.reciprocal() : result;
+    }
+
+    // Inverso de la fracción: el signo pasa al nuevo numerador y el 0 no tiene inverso
+    // La inversa de una fracción reducida sigue reducida
+    BigRational reciprocal() const {
+        if(numerator.number.isZero())
+            throw BigNumberDivisionByZero();
+        BigInteger<Base> newNum(denominator);
+        newNum.isNegative = numerator.isNegative;
+        return BigRational(newNum, numerator.number, true);
     }
 
-    // Métodos virtuales de BigNumber utilizando conversión
-    virtual BigNumber<Base>& add(const BigNumber<Base>& other) const {
-        BigRational otherConv = other;  // Se utiliza el operador de conversión a BigRational
-        BigRational* res = new BigRational((*this) + otherConv);
-        return *res;
+    // Operador división
+    // (a/b) / (c/d) = (a/b) * (d/c), de modo que la multiplicación aplica la simplificación
+    // cruzada mcd(a, c) y mcd(d, b) antes de multiplicar
+    BigRational operator/(const BigRational& other) const {
+        return (*this) * other.reciprocal();
     }
-    virtual BigNumber<Base>& subtract(const BigNumber<Base>& other) const {
-        BigRational otherConv = other;
-        BigRational* res = new BigRational((*this) - otherConv);
-        return *res;
+
+    // Operadores compuestos
+    // Los algoritmos de Henrici construyen numerador y denominador nuevos, así que el
+    // resultado se mueve a *this en lugar de copiarse
+    BigRational& operator+=(const BigRational& other) {
+        return *this = addHenrici(other, false);
+    }
+
+    BigRational& operator-=(const BigRational& other) {
+        return *this = addHenrici(other, true);
     }
-    virtual BigNumber<Base>& multiply(const BigNumber<Base>& other) const {
-        BigRational otherConv = other;
-        BigRational* res = new BigRational((*this) * otherConv);
-        return *res;
+
+    BigRational& operator*=(const BigRational& other) {
+        return *this = (*this) * other;
+    }
+
+    BigRational& operator/=(const BigRational& other) {
+        return *this = (*this) / other;
+    }
+
+    // El resto de la división no está definido para racionales
+    BigRational operator%(const BigRational&) const {
+        throw BigNumberException();
+    }
+
+    // Métodos virtuales de BigNumber
+    // La suma, resta, multiplicación, división y módulo los resuelve la tabla de BigNumber
+    virtual typename BigNumber<Base>::Kind kind() const {
+        return BigNumber<Base>::RATIONAL;
+    }
+    virtual std::unique_ptr<BigNumber<Base>> power(const BigNumber<Base>& other) const {
+        bool negative;
+        BigUnsigned<Base> exponent = BigNumber<Base>::exponentOf(other, negative);
+        return BigNumber<Base>::makeOwned(pow(exponent, negative));
     }
 
     // Operadores de conversión
@@ -96,9 +217,15 @@ public:
         std::string den = s.substr(pos+1);
         numerator = BigInteger<Base>(num.c_str());
         denominator = BigUnsigned<Base>(den.c_str());
+        normalize();
         return in;
     }
 
+    // BigNumber necesita consultar el denominador para validar exponentes
+    friend class BigNumber<Base>;
+    // La conversión entre bases lee numerador y denominador de las otras instancias
+    template <unsigned char> friend class BigRational;
+
     // Sobrecarga del operador << para imprimir BigRational
     template <unsigned char B>
     friend std::ostream& operator<<(std::ostream& out, const BigRational<B>& num);
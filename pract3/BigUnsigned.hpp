@@ -2,21 +2,90 @@
 #define BIGUNSIGNED_HPP
 
 #include "BigNumber.hpp"
+#include "LimbBuffer.hpp"
 #include <iostream>
 #include <vector>
 #include <string>
 #include <cctype>
 #include <algorithm>
+#include <cstdint>
+#include <utility>
+#if defined(__SSE2__) && !defined(BIGNUM_NO_SIMD)
+#include <immintrin.h>
+#endif
 
 // Daniel Palenzuela Álvarez alu0101140469
 
+// Funciones auxiliares evaluadas en tiempo de compilación para calcular el tamaño de los limbs
+namespace bigdetail {
+    // Número máximo de dígitos en base 'base' que caben en un limb, manteniendo base^k <= 2^30
+    // El margen de 2 bits permite sumar limbs y acumular productos en 64 bits sin desbordar
+    constexpr unsigned limbDigits(unsigned base, unsigned long long acc = 1, unsigned k = 0) {
+        return (acc * base > (1ULL << 30)) ? k : limbDigits(base, acc * base, k + 1);
+    }
+    // Potencia entera base^exp
+    constexpr unsigned long long ipow(unsigned base, unsigned exp) {
+        return exp == 0 ? 1 : base * ipow(base, exp - 1);
+    }
+    // Indica si x es una potencia de dos
+    constexpr bool isPowerOfTwo(unsigned long long x) {
+        return x != 0 && (x & (x - 1)) == 0;
+    }
+    // Parte entera del logaritmo en base 2 de x (x > 0)
+    constexpr unsigned floorLog2(unsigned long long x) {
+        return x <= 1 ? 0 : 1 + floorLog2(x >> 1);
+    }
+
+    // División de enteros de 64 bits entre un divisor d conocido solo en ejecución
+    // Se precalcula inv = floor((2^64-1)/d) y el cociente de n se estima con la parte alta de
+    // n*inv, que nunca se pasa y se queda corta como mucho en 1, así que basta una corrección.
+    // Sustituye a la instrucción de división (decenas de ciclos) en los bucles que dividen
+    // muchos limbs entre el mismo valor
+    class LimbDivisor {
+    public:
+        explicit LimbDivisor(std::uint64_t divisor)
+            : d(divisor), inv(~std::uint64_t(0) / divisor) {}
+
+        std::uint64_t divide(std::uint64_t n, std::uint64_t& rem) const {
+            std::uint64_t q = (std::uint64_t)(((unsigned __int128)n * inv) >> 64);
+            rem = n - q * d;
+            if(rem >= d) {
+                q++;
+                rem -= d;
+            }
+            return q;
+        }
+
+    private:
+        std::uint64_t d, inv;
+    };
+}
+
 // Clase para números grandes sin signo
 template <unsigned char Base>
 class BigUnsigned : public BigNumber<Base> {
 private:
-    // Vector que almacena los dígitos en orden inverso
-    // El dígito menos significativo está en el índice 0
-    std::vector<unsigned char> digits;
+    // Tipo de cada limb y tipo doble para los productos y acarreos intermedios
+    typedef std::uint32_t limb_t;
+    typedef std::uint64_t dlimb_t;
+
+    // Cada limb empaqueta LIMB_DIGITS dígitos de la base, es decir, es un dígito en base LIMB_BASE
+    static constexpr unsigned LIMB_DIGITS = bigdetail::limbDigits(Base);
+    static constexpr limb_t LIMB_BASE = static_cast<limb_t>(bigdetail::ipow(Base, LIMB_DIGITS));
+    // Si la base es potencia de dos, cada limb guarda exactamente LIMB_BITS bits del número
+    // (30 en las bases 2, 4, 8 y 32, y 28 en base 16)
+    static constexpr unsigned LIMB_BITS = bigdetail::floorLog2(LIMB_BASE);
+
+    // Limbs que se guardan dentro del propio objeto, sin reservar memoria: 8 limbs cubren los
+    // números de hasta 72 dígitos en base 10 (80 en base 8 y 56 en base 16), que es el tamaño
+    // habitual de los operandos y de los temporales de las operaciones
+    static const size_t INLINE_LIMBS = 8;
+    typedef LimbBuffer<limb_t, INLINE_LIMBS> limbs_t;
+
+    // Vector que almacena los limbs en orden inverso
+    // El limb menos significativo está en el índice 0 y nunca hay limbs nulos en la parte alta,
+    // por lo que el número 0 se representa con el vector vacío
+    limbs_t limbs;
 
     // Función auxiliar que convierte un carácter en un dígito (verificando la validez para la base)
     unsigned char charToDigit(char c) const {
@@ -38,191 +107,1652 @@ private:
         return (d < 10) ? ('0' + d) : ('A' + (d - 10));
     }
 
+    // Elimina los limbs nulos de la parte alta para mantener la representación canónica
+    void trim() {
+        while(!limbs.empty() && limbs.back() == 0)
+            limbs.pop_back();
+    }
+
+    // Vista sin propiedad sobre un tramo de limbs (puntero y longitud)
+    // Permite que los algoritmos recursivos operen con partes de un número sin copiarlas.
+    // La longitud no cuenta los limbs nulos de la parte alta, igual que en BigUnsigned.
+    // Solo es válida mientras no se modifique el número al que apunta
+    class View {
+    public:
+        View() : ptr(nullptr), len(0) {}
+        View(const limb_t* p, size_t n) : ptr(p), len(normLen(p, n)) {}
+
+        const limb_t* data() const { return ptr; }
+        size_t size() const { return len; }
+        bool empty() const { return len == 0; }
+        limb_t operator[](size_t i) const { return ptr[i]; }
+
+        // Vista de value mod LIMB_BASE^k
+        View low(size_t k) const {
+            return View(ptr, std::min(k, len));
+        }
+        // Vista de value / LIMB_BASE^k
+        View high(size_t k) const {
+            return (k < len) ? View(ptr + k, len - k) : View();
+        }
+
+    private:
+        const limb_t* ptr;
+        size_t len;
+    };
+
+    // Copia el tramo de la vista en un número nuevo
+    explicit BigUnsigned(View v) : limbs(v.data(), v.data() + v.size()) {}
+
+    // Vista del número completo
+    View view() const {
+        return View(limbs.data(), limbs.size());
+    }
+
+    // Umbrales (en limbs del operando menor) a partir de los cuales se usa Karatsuba, Toom-3
+    // y la NTT en lugar del algoritmo anterior. Se pueden ajustar con setMultiplyThresholds
+    // Los valores por defecto son los cruces medidos con make bench (bench_multiply.cpp)
+    static size_t karatsubaThreshold;
+    static size_t toomThreshold;
+    static size_t nttThreshold;
+
+    // Tamaño (en limbs) del divisor y del cociente a partir del cual se divide con
+    // Burnikel-Ziegler en lugar del algoritmo D de Knuth
+    static size_t bzThreshold;
+
+    // Tamaño (en limbs) a partir del cual el máximo común divisor usa el medio mcd recursivo
+    // en lugar de solo pasos de Lehmer
+    static size_t gcdThreshold;
+
+    // Margen (en limbs) con el que para el medio mcd: a partir de un número de n limbs se reduce
+    // hasta que el resto tiene como mucho n/2 + HGCD_MARGIN limbs. Los restos quedan así por encima
+    // de las entradas de la matriz de cocientes, que rondan LIMB_BASE^(n/2)
+    static const size_t HGCD_MARGIN = 2;
+
+    // Longitud máxima de la transformada: 998244353 = 119*2^23 + 1 solo tiene raíces de orden 2^23
+    static const size_t NTT_MAX_LENGTH = size_t(1) << 23;
+
+    // Tamaño máximo (en bits) del resultado de pow: 2^26 bits son unos 20 millones de dígitos
+    // decimales, y cualquier potencia mayor agotaría la memoria o tardaría demasiado
+    static const unsigned long long MAX_POWER_BITS = 1ULL << 26;
+
+    // Número con signo sobre un vector de limbs, usado en las evaluaciones de Toom-Cook,
+    // donde los puntos negativos producen valores intermedios negativos
+    struct SignedLimbs {
+        std::vector<limb_t> mag;
+        bool neg;
+        SignedLimbs() : neg(false) {}
+        SignedLimbs(const limb_t* a, size_t n) : mag(a, a + normLen(a, n)), neg(false) {}
+    };
+
+    // Longitud de un vector de limbs sin contar los limbs nulos de la parte alta
+    static size_t normLen(const limb_t* a, size_t n) {
+        while(n > 0 && a[n-1] == 0)
+            n--;
+        return n;
+    }
+
+    // Núcleos vectoriales de suma, resta y comparación (AVX2 con 8 limbs por bloque o SSE2 con 4)
+    // Cada bloque suma (o resta) todos sus limbs a la vez. Como los limbs son menores que 2^30,
+    // las sumas caben en un entero con signo y bastan las comparaciones con signo de SSE2/AVX2.
+    // Los acarreos se resuelven con un prefijo paralelo sobre máscaras de bits: g marca los limbs
+    // que generan acarreo (suma >= LIMB_BASE), p los que lo propagan (suma == LIMB_BASE - 1) y
+    // la suma entera (g|p) + g + acarreo deja en cada bit, tras quitar p, el acarreo que entra en
+    // ese limb; el bit siguiente al último es el acarreo que sale del bloque.
+    // Procesan los bloques completos de r[0..n) y b[0..n) y devuelven cuántos limbs han tratado;
+    // sin SIMD (o definiendo BIGNUM_NO_SIMD) no tratan ninguno y todo lo hace el bucle escalar
+#if defined(__AVX2__) && !defined(BIGNUM_NO_SIMD)
+    static const size_t SIMD_LANES = 8;
+
+    // Vector con -1 en los carriles cuyo bit está activo en mask y 0 en el resto
+    static __m256i laneMask(unsigned mask) {
+        const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(mask), bits), bits);
+    }
+    static unsigned signMask(__m256i x) {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(x));
+    }
+
+    static size_t addSimd(limb_t* r, const limb_t* b, size_t n, limb_t& carry) {
+        const __m256i top = _mm256_set1_epi32(LIMB_BASE - 1), base = _mm256_set1_epi32(LIMB_BASE);
+        size_t i = 0;
+        for(; i + SIMD_LANES <= n; i += SIMD_LANES) {
+            __m256i s = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(r + i)),
+                                         _mm256_loadu_si256((const __m256i*)(b + i)));
+            unsigned g = signMask(_mm256_cmpgt_epi32(s, top));
+            unsigned p = signMask(_mm256_cmpeq_epi32(s, top));
+            unsigned prefix = (g | p) + g + carry;
+            carry = prefix >> SIMD_LANES;
+            s = _mm256_sub_epi32(s, laneMask(prefix ^ p));
+            s = _mm256_sub_epi32(s, _mm256_and_si256(_mm256_cmpgt_epi32(s, top), base));
+            _mm256_storeu_si256((__m256i*)(r + i), s);
+        }
+        return i;
+    }
+
+    static size_t subSimd(limb_t* r, const limb_t* b, size_t n, limb_t& borrow) {
+        const __m256i zero = _mm256_setzero_si256(), base = _mm256_set1_epi32(LIMB_BASE);
+        size_t i = 0;
+        for(; i + SIMD_LANES <= n; i += SIMD_LANES) {
+            __m256i d = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i*)(r + i)),
+                                         _mm256_loadu_si256((const __m256i*)(b + i)));
+            unsigned g = signMask(d);
+            unsigned p = signMask(_mm256_cmpeq_epi32(d, zero));
+            unsigned prefix = (g | p) + g + borrow;
+            borrow = prefix >> SIMD_LANES;
+            d = _mm256_add_epi32(d, laneMask(prefix ^ p));
+            d = _mm256_add_epi32(d, _mm256_and_si256(_mm256_cmpgt_epi32(zero, d), base));
+            _mm256_storeu_si256((__m256i*)(r + i), d);
+        }
+        return i;
+    }
+
+    // Número de limbs iguales en la parte alta de a[0..n) y b[0..n), por bloques desde arriba
+    static size_t equalTopSimd(const limb_t* a, const limb_t* b, size_t n) {
+        size_t i = n;
+        for(; i >= SIMD_LANES; i -= SIMD_LANES) {
+            __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(a + i - SIMD_LANES)),
+                                            _mm256_loadu_si256((const __m256i*)(b + i - SIMD_LANES)));
+            if(signMask(eq) != 0xFF)
+                break;
+        }
+        return n - i;
+    }
+#elif defined(__SSE2__) && !defined(BIGNUM_NO_SIMD)
+    static const size_t SIMD_LANES = 4;
+
+    static __m128i laneMask(unsigned mask) {
+        const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+        return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(mask), bits), bits);
+    }
+    static unsigned signMask(__m128i x) {
+        return _mm_movemask_ps(_mm_castsi128_ps(x));
+    }
+
+    static size_t addSimd(limb_t* r, const limb_t* b, size_t n, limb_t& carry) {
+        const __m128i top = _mm_set1_epi32(LIMB_BASE - 1), base = _mm_set1_epi32(LIMB_BASE);
+        size_t i = 0;
+        for(; i + SIMD_LANES <= n; i += SIMD_LANES) {
+            __m128i s = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(r + i)),
+                                      _mm_loadu_si128((const __m128i*)(b + i)));
+            unsigned g = signMask(_mm_cmpgt_epi32(s, top));
+            unsigned p = signMask(_mm_cmpeq_epi32(s, top));
+            unsigned prefix = (g | p) + g + carry;
+            carry = prefix >> SIMD_LANES;
+            s = _mm_sub_epi32(s, laneMask(prefix ^ p));
+            s = _mm_sub_epi32(s, _mm_and_si128(_mm_cmpgt_epi32(s, top), base));
+            _mm_storeu_si128((__m128i*)(r + i), s);
+        }
+        return i;
+    }
+
+    static size_t subSimd(limb_t* r, const limb_t* b, size_t n, limb_t& borrow) {
+        const __m128i zero = _mm_setzero_si128(), base = _mm_set1_epi32(LIMB_BASE);
+        size_t i = 0;
+        for(; i + SIMD_LANES <= n; i += SIMD_LANES) {
+            __m128i d = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(r + i)),
+                                      _mm_loadu_si128((const __m128i*)(b + i)));
+            unsigned g = signMask(d);
+            unsigned p = signMask(_mm_cmpeq_epi32(d, zero));
+            unsigned prefix = (g | p) + g + borrow;
+            borrow = prefix >> SIMD_LANES;
+            d = _mm_add_epi32(d, laneMask(prefix ^ p));
+            d = _mm_add_epi32(d, _mm_and_si128(_mm_cmpgt_epi32(zero, d), base));
+            _mm_storeu_si128((__m128i*)(r + i), d);
+        }
+        return i;
+    }
+
+    static size_t equalTopSimd(const limb_t* a, const limb_t* b, size_t n) {
+        size_t i = n;
+        for(; i >= SIMD_LANES; i -= SIMD_LANES) {
+            __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(a + i - SIMD_LANES)),
+                                         _mm_loadu_si128((const __m128i*)(b + i - SIMD_LANES)));
+            if(signMask(eq) != 0xF)
+                break;
+        }
+        return n - i;
+    }
+#else
+    static size_t addSimd(limb_t*, const limb_t*, size_t, limb_t&) { return 0; }
+    static size_t subSimd(limb_t*, const limb_t*, size_t, limb_t&) { return 0; }
+    static size_t equalTopSimd(const limb_t*, const limb_t*, size_t) { return 0; }
+#endif
+
+    // Suma en el sitio: r[0..rn) += b[0..bn), con rn >= bn. Devuelve el acarreo final
+    static limb_t addInPlace(limb_t* r, size_t rn, const limb_t* b, size_t bn) {
+        limb_t carry = 0;
+        size_t i = addSimd(r, b, bn, carry);
+        for(; i < bn; i++){
+            limb_t sum = r[i] + b[i] + carry;
+            carry = (sum >= LIMB_BASE);
+            r[i] = carry ? sum - LIMB_BASE : sum;
+        }
+        for(; carry && i < rn; i++){
+            limb_t sum = r[i] + carry;
+            carry = (sum >= LIMB_BASE);
+            r[i] = carry ? sum - LIMB_BASE : sum;
+        }
+        return carry;
+    }
+
+    // Resta en el sitio: r[0..rn) -= b[0..bn), con rn >= bn. Devuelve el préstamo final
+    static limb_t subInPlace(limb_t* r, size_t rn, const limb_t* b, size_t bn) {
+        limb_t borrow = 0;
+        size_t i = subSimd(r, b, bn, borrow);
+        for(; i < bn; i++){
+            limb_t d = b[i] + borrow;
+            borrow = (r[i] < d);
+            r[i] = borrow ? r[i] + LIMB_BASE - d : r[i] - d;
+        }
+        for(; borrow && i < rn; i++){
+            borrow = (r[i] == 0);
+            r[i] = borrow ? LIMB_BASE - 1 : r[i] - 1;
+        }
+        return borrow;
+    }
+
+    // Lado (en limbs) de los bloques de la multiplicación clásica: dos tramos de operando y el
+    // acumulador de 64 bits de un bloque ocupan unos 1.5 KB y se quedan en la caché L1
+    static const size_t MUL_TILE = 64;
+
+    // Filas de productos parciales que admite un acumulador de 64 bits sin normalizar
+    // Cada producto es como mucho (LIMB_BASE-1)^2, y se reserva sitio para lo que queda tras
+    // normalizar, un limb de r y el acarreo del acumulador anterior
+    // (18 filas en base 10, 16 en base 8 y más de 250 en base 16)
+    static constexpr dlimb_t MUL_FOLD_ROWS =
+        (~dlimb_t(0) - 2*(dlimb_t)(LIMB_BASE - 1) - ~dlimb_t(0) / LIMB_BASE) /
+        ((dlimb_t)(LIMB_BASE - 1) * (LIMB_BASE - 1));
+
+    // Normaliza los acumuladores acc[0..n) a limbs menores que LIMB_BASE propagando el acarreo
+    // El valor acumulado cabe siempre en n limbs, así que no sobra acarreo al final
+    static void foldCarries(dlimb_t* acc, size_t n) {
+        dlimb_t carry = 0;
+        for(size_t k = 0; k < n; k++){
+            dlimb_t current = acc[k] + carry;
+            acc[k] = current % LIMB_BASE;
+            carry = current / LIMB_BASE;
+        }
+    }
+
+    // Suma los acumuladores de un bloque, acc[0..n), a out[0..) propagando el acarreo
+    // El resultado parcial cabe siempre en el buffer de out, así que el acarreo se agota dentro
+    static void addAccumulators(limb_t* out, const dlimb_t* acc, size_t n) {
+        dlimb_t carry = 0;
+        size_t k = 0;
+        for(; k < n; k++){
+            dlimb_t current = acc[k] + out[k] + carry;
+            out[k] = current % LIMB_BASE;
+            carry = current / LIMB_BASE;
+        }
+        for(; carry; k++){
+            carry = (out[k] == LIMB_BASE - 1);
+            out[k] = carry ? 0 : out[k] + 1;
+        }
+    }
+
+    // Multiplicación clásica: r[0..na+nb) = a * b
+    // Se recorre el producto por bloques de MUL_TILE x MUL_TILE limbs. Dentro de cada bloque
+    // los productos parciales se suman en acumuladores de 64 bits sin reducirlos, y el % y / por
+    // LIMB_BASE solo se hacen cada MUL_FOLD_ROWS filas y al volcar el bloque sobre r
+    static void mulSchool(limb_t* r, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        std::fill(r, r + na + nb, 0);
+        dlimb_t acc[2*MUL_TILE];
+        for(size_t j0 = 0; j0 < nb; j0 += MUL_TILE){
+            size_t tb = (nb - j0 < MUL_TILE) ? nb - j0 : MUL_TILE;
+            for(size_t i0 = 0; i0 < na; i0 += MUL_TILE){
+                size_t ta = (na - i0 < MUL_TILE) ? na - i0 : MUL_TILE;
+                std::fill(acc, acc + ta + tb, 0);
+                for(size_t j = 0; j < tb; j++){
+                    if(j > 0 && j % MUL_FOLD_ROWS == 0)
+                        foldCarries(acc, ta + tb);
+                    dlimb_t bj = b[j0 + j];
+                    dlimb_t* row = acc + j;
+                    const limb_t* ai = a + i0;
+                    for(size_t i = 0; i < ta; i++)
+                        row[i] += ai[i] * bj;
+                }
+                addAccumulators(r + i0 + j0, acc, ta + tb);
+            }
+        }
+    }
+
+    // Cuadrado clásico: r[0..2n) = a^2
+    // Cada producto cruzado a[i]*a[j] (i < j) se acumula una sola vez, por bloques de
+    // MUL_TILE x MUL_TILE limbs como en mulSchool: solo se recorren los bloques con columnas
+    // j0 >= i0, y en los de la diagonal solo las columnas j > i. En la pasada final se duplica
+    // la suma y se añaden los cuadrados de la diagonal
+    static void sqrSchool(limb_t* r, const limb_t* a, size_t n) {
+        std::fill(r, r + 2*n, 0);
+        dlimb_t acc[2*MUL_TILE];
+        for(size_t i0 = 0; i0 < n; i0 += MUL_TILE){
+            size_t ti = (n - i0 < MUL_TILE) ? n - i0 : MUL_TILE;
+            for(size_t j0 = i0; j0 < n; j0 += MUL_TILE){
+                size_t tj = (n - j0 < MUL_TILE) ? n - j0 : MUL_TILE;
+                std::fill(acc, acc + ti + tj, 0);
+                for(size_t i = 0; i < ti; i++){
+                    if(i > 0 && i % MUL_FOLD_ROWS == 0)
+                        foldCarries(acc, ti + tj);
+                    dlimb_t ai = a[i0 + i];
+                    const limb_t* aj = a + j0;
+                    for(size_t j = (j0 == i0) ? i + 1 : 0; j < tj; j++)
+                        acc[i + j] += ai * aj[j];
+                }
+                addAccumulators(r + i0 + j0, acc, ti + tj);
+            }
+        }
+        dlimb_t carry = 0;
+        for(size_t i = 0; i < n; i++){
+            dlimb_t low = 2*(dlimb_t)r[2*i] + (dlimb_t)a[i] * a[i] + carry;
+            r[2*i] = low % LIMB_BASE;
+            dlimb_t high = 2*(dlimb_t)r[2*i+1] + low / LIMB_BASE;
+            r[2*i+1] = high % LIMB_BASE;
+            carry = high / LIMB_BASE;
+        }
+    }
+
+    // Multiplicación de Karatsuba: r[0..na+nb) = a * b, con na >= nb > na/2
+    // Se parte en m = na/2 limbs: a = a1*B^m + a0, b = b1*B^m + b0, y se usa
+    // a0*b1 + a1*b0 = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
+    // Si a y b son el mismo operando, los tres productos son cuadrados
+    static void mulKaratsuba(limb_t* r, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        size_t m = na / 2;
+        const limb_t* a1 = a + m;
+        const limb_t* b1 = b + m;
+        size_t na1 = na - m, nb1 = nb - m;
+        // a0*b0 ocupa r[0..2m) y a1*b1 ocupa r[2m..na+nb)
+        multiplyLimbs(r, a, m, b, m);
+        multiplyLimbs(r + 2*m, a1, na1, b1, nb1);
+        // Sumas de las mitades (na1 >= m y nb1 puede ser menor que m)
+        std::vector<limb_t> sa(a1, a1 + na1), sb;
+        sa.push_back(addInPlace(sa.data(), na1, a, m));
+        size_t lsa = normLen(sa.data(), sa.size());
+        const limb_t* psb = sa.data();
+        size_t lsb = lsa;
+        if(a != b || na != nb) {
+            sb.assign(std::max(m, nb1), 0);
+            std::copy(b, b + m, sb.begin());
+            sb.push_back(addInPlace(sb.data(), sb.size(), b1, nb1));
+            psb = sb.data();
+            lsb = normLen(psb, sb.size());
+        }
+        std::vector<limb_t> mid(lsa + lsb);
+        multiplyLimbs(mid.data(), sa.data(), lsa, psb, lsb);
+        // Se restan a0*b0 y a1*b1 para obtener el término central
+        subInPlace(mid.data(), mid.size(), r, normLen(r, 2*m));
+        subInPlace(mid.data(), mid.size(), r + 2*m, normLen(r + 2*m, na1 + nb1));
+        addInPlace(r + m, na + nb - m, mid.data(), normLen(mid.data(), mid.size()));
+    }
+
+    // Compara dos vectores de limbs normalizados. Devuelve -1, 0 o 1
+    static int compareLimbs(const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        if(na != nb)
+            return (na < nb) ? -1 : 1;
+        // Los bloques altos iguales se saltan de golpe y el resto se compara limb a limb
+        for(size_t i = na - equalTopSimd(a, b, na); i-- > 0; ){
+            if(a[i] != b[i])
+                return (a[i] < b[i]) ? -1 : 1;
+        }
+        return 0;
+    }
+
+    // Divide en el sitio por un valor pequeño, sabiendo que la división es exacta
+    static void divSmallExact(std::vector<limb_t>& x, limb_t d) {
+        dlimb_t rem = 0;
+        for(size_t i = x.size(); i-- > 0; ){
+            dlimb_t current = rem * LIMB_BASE + x[i];
+            x[i] = current / d;
+            rem = current % d;
+        }
+        x.resize(normLen(x.data(), x.size()));
+    }
+
+    // Suma (o resta si subtract es true) de dos números con signo
+    static SignedLimbs signedAdd(const SignedLimbs& x, const SignedLimbs& y, bool subtract) {
+        bool yNeg = (y.neg != subtract);
+        SignedLimbs r;
+        if(x.neg == yNeg) {
+            const std::vector<limb_t>& big = (x.mag.size() >= y.mag.size()) ? x.mag : y.mag;
+            const std::vector<limb_t>& small = (x.mag.size() >= y.mag.size()) ? y.mag : x.mag;
+            r.mag = big;
+            r.mag.push_back(addInPlace(r.mag.data(), big.size(), small.data(), small.size()));
+            r.neg = x.neg;
+        } else if(compareLimbs(x.mag.data(), x.mag.size(), y.mag.data(), y.mag.size()) >= 0) {
+            r.mag = x.mag;
+            subInPlace(r.mag.data(), r.mag.size(), y.mag.data(), y.mag.size());
+            r.neg = x.neg;
+        } else {
+            r.mag = y.mag;
+            subInPlace(r.mag.data(), r.mag.size(), x.mag.data(), x.mag.size());
+            r.neg = yNeg;
+        }
+        r.mag.resize(normLen(r.mag.data(), r.mag.size()));
+        if(r.mag.empty())
+            r.neg = false;
+        return r;
+    }
+
+    // Producto de dos números con signo
+    static SignedLimbs signedMul(const SignedLimbs& x, const SignedLimbs& y) {
+        SignedLimbs r;
+        if(x.mag.empty() || y.mag.empty())
+            return r;
+        r.mag.resize(x.mag.size() + y.mag.size());
+        multiplyLimbs(r.mag.data(), x.mag.data(), x.mag.size(), y.mag.data(), y.mag.size());
+        r.mag.resize(normLen(r.mag.data(), r.mag.size()));
+        r.neg = (x.neg != y.neg);
+        return r;
+    }
+
+    // Trozo [from, from+len) de un vector de limbs, recortado a la longitud disponible
+    static SignedLimbs piece(const limb_t* a, size_t n, size_t from, size_t len) {
+        if(from >= n)
+            return SignedLimbs();
+        return SignedLimbs(a + from, std::min(len, n - from));
+    }
+
+    // Suma los coeficientes c[i] desplazados i*k limbs sobre r[0..n), previamente puesto a 0
+    static void recompose(limb_t* r, size_t n, const SignedLimbs* c, size_t count, size_t k) {
+        std::fill(r, r + n, 0);
+        for(size_t i = 0; i < count; i++){
+            if(!c[i].mag.empty())
+                addInPlace(r + i*k, n - i*k, c[i].mag.data(), c[i].mag.size());
+        }
+    }
+
+    // Evalúa en 0, 1, -1, -2 e infinito el polinomio de tres trozos de k limbs de a
+    static void toom3Evaluate(const limb_t* a, size_t na, size_t k, SignedLimbs* p) {
+        SignedLimbs a0 = piece(a, na, 0, k), a1 = piece(a, na, k, k), a2 = piece(a, na, 2*k, k);
+        SignedLimbs t = signedAdd(a0, a2, false);
+        p[1] = signedAdd(t, a1, false);
+        p[2] = signedAdd(t, a1, true);
+        p[3] = signedAdd(p[2], a2, false);
+        p[3] = signedAdd(signedAdd(p[3], p[3], false), a0, true);
+        p[0] = a0;
+        p[4] = a2;
+    }
+
+    // Multiplicación Toom-3: r[0..na+nb) = a * b, con a y b partidos en tres trozos de k limbs
+    // Se evalúa en 0, 1, -1, -2 e infinito y se interpola con la secuencia de Bodrato
+    // Si a y b son el mismo operando se evalúa una sola vez y los productos puntuales son cuadrados
+    static void mulToom3(limb_t* r, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        size_t k = (na + 2) / 3;
+        SignedLimbs pa[5], pb[5];
+        toom3Evaluate(a, na, k, pa);
+        const SignedLimbs* pq = pa;
+        if(a != b || na != nb) {
+            toom3Evaluate(b, nb, k, pb);
+            pq = pb;
+        }
+        // Productos puntuales
+        SignedLimbs r0 = signedMul(pa[0], pq[0]), r1 = signedMul(pa[1], pq[1]);
+        SignedLimbs rm1 = signedMul(pa[2], pq[2]), rm2 = signedMul(pa[3], pq[3]);
+        SignedLimbs rinf = signedMul(pa[4], pq[4]);
+        // Interpolación
+        SignedLimbs c3 = signedAdd(rm2, r1, true);
+        divSmallExact(c3.mag, 3);
+        SignedLimbs c1 = signedAdd(r1, rm1, true);
+        divSmallExact(c1.mag, 2);
+        SignedLimbs c2 = signedAdd(rm1, r0, true);
+        c3 = signedAdd(c2, c3, true);
+        divSmallExact(c3.mag, 2);
+        c3 = signedAdd(c3, signedAdd(rinf, rinf, false), false);
+        c2 = signedAdd(signedAdd(c2, c1, false), rinf, true);
+        c1 = signedAdd(c1, c3, true);
+        SignedLimbs c[5] = { r0, c1, c2, c3, rinf };
+        recompose(r, na + nb, c, 5, k);
+    }
+
+    // Multiplicación Toom-2.5: r[0..na+nb) = a * b, con a partido en tres trozos de k limbs y
+    // b en dos, para operandos desequilibrados. Se evalúa en 0, 1, -1 e infinito
+    static void mulToom25(limb_t* r, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        size_t k = (na + 2) / 3;
+        SignedLimbs a0 = piece(a, na, 0, k), a1 = piece(a, na, k, k), a2 = piece(a, na, 2*k, k);
+        SignedLimbs b0 = piece(b, nb, 0, k), b1 = piece(b, nb, k, k);
+        SignedLimbs ta = signedAdd(a0, a2, false);
+        SignedLimbs r0 = signedMul(a0, b0), rinf = signedMul(a2, b1);
+        SignedLimbs r1 = signedMul(signedAdd(ta, a1, false), signedAdd(b0, b1, false));
+        SignedLimbs rm1 = signedMul(signedAdd(ta, a1, true), signedAdd(b0, b1, true));
+        // c2 = (r1 + rm1)/2 - r0 y c1 = (r1 - rm1)/2 - rinf
+        SignedLimbs c2 = signedAdd(r1, rm1, false);
+        divSmallExact(c2.mag, 2);
+        c2 = signedAdd(c2, r0, true);
+        SignedLimbs c1 = signedAdd(r1, rm1, true);
+        divSmallExact(c1.mag, 2);
+        c1 = signedAdd(c1, rinf, true);
+        SignedLimbs c[4] = { r0, c1, c2, rinf };
+        recompose(r, na + nb, c, 4, k);
+    }
+
+    // Primos de la NTT, todos de la forma c*2^k + 1 con raíz primitiva 3
+    // Su producto (~2^86) supera el mayor coeficiente posible de la convolución,
+    // min(na,nb)*(LIMB_BASE-1)^2 < 2^22 * 2^60, por lo que la reconstrucción es exacta
+    // Son constantes de compilación y se pasan como parámetro de plantilla a la transformada,
+    // de modo que el compilador sustituye cada reducción % Mod por multiplicaciones y
+    // desplazamientos en lugar de una división de 64 bits por mariposa
+    static constexpr limb_t NTT_PRIME0 = 998244353;
+    static constexpr limb_t NTT_PRIME1 = 167772161;
+    static constexpr limb_t NTT_PRIME2 = 469762049;
+
+    // Potencia modular b^e mod m (m < 2^30, por lo que los productos caben en 64 bits)
+    static dlimb_t powMod(dlimb_t b, dlimb_t e, dlimb_t m) {
+        dlimb_t result = 1;
+        b %= m;
+        while(e) {
+            if(e & 1) result = result * b % m;
+            b = b * b % m;
+            e >>= 1;
+        }
+        return result;
+    }
+
+    // Transformada teórica de números en el sitio (Cooley-Tukey iterativa) módulo Mod
+    // x.size() debe ser potencia de 2; si invert es true se calcula la transformada inversa
+    template <limb_t Mod>
+    static void ntt(std::vector<limb_t>& x, bool invert) {
+        const dlimb_t mod = Mod;
+        size_t n = x.size();
+        // Permutación por inversión de bits
+        for(size_t i = 1, j = 0; i < n; i++){
+            size_t bit = n >> 1;
+            for(; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+            if(i < j)
+                std::swap(x[i], x[j]);
+        }
+        for(size_t len = 2; len <= n; len <<= 1){
+            dlimb_t root = powMod(3, (mod - 1) / len, mod);
+            if(invert)
+                root = powMod(root, mod - 2, mod);
+            // Potencias de la raíz para esta etapa, compartidas por todos los bloques
+            std::vector<limb_t> w(len / 2);
+            w[0] = 1;
+            for(size_t k = 1; k < len / 2; k++)
+                w[k] = (dlimb_t)w[k-1] * root % mod;
+            for(size_t i = 0; i < n; i += len){
+                for(size_t k = 0; k < len / 2; k++){
+                    limb_t u = x[i+k];
+                    limb_t v = (dlimb_t)x[i+k+len/2] * w[k] % mod;
+                    x[i+k] = (u + v >= mod) ? u + v - mod : u + v;
+                    x[i+k+len/2] = (u >= v) ? u - v : u + mod - v;
+                }
+            }
+        }
+        if(invert) {
+            dlimb_t nInv = powMod(n, mod - 2, mod);
+            for(size_t i = 0; i < n; i++)
+                x[i] = x[i] * nInv % mod;
+        }
+    }
+
+    // Convolución cíclica de a y b módulo el primo Mod, de longitud n (potencia de 2)
+    // Para un cuadrado (a y b son el mismo operando) basta con una transformada directa
+    template <limb_t Mod>
+    static std::vector<limb_t> nttConvolution(const limb_t* a, size_t na, const limb_t* b, size_t nb,
+                                              size_t n) {
+        const dlimb_t mod = Mod;
+        std::vector<limb_t> fa(a, a + na);
+        fa.resize(n);
+        ntt<Mod>(fa, false);
+        if(a == b && na == nb) {
+            for(size_t k = 0; k < n; k++)
+                fa[k] = (dlimb_t)fa[k] * fa[k] % mod;
+        } else {
+            std::vector<limb_t> fb(b, b + nb);
+            fb.resize(n);
+            ntt<Mod>(fb, false);
+            for(size_t k = 0; k < n; k++)
+                fa[k] = (dlimb_t)fa[k] * fb[k] % mod;
+        }
+        ntt<Mod>(fa, true);
+        return fa;
+    }
+
+    // Multiplicación por NTT: r[0..na+nb) = a * b
+    // Se calcula la convolución módulo tres primos y se reconstruye cada coeficiente con el
+    // algoritmo de Garner (CRT), propagando el acarreo en base LIMB_BASE sin aritmética de 128 bits
+    static void mulNTT(limb_t* r, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        size_t n = 1;
+        while(n < na + nb - 1)
+            n <<= 1;
+        std::vector<limb_t> c0 = nttConvolution<NTT_PRIME0>(a, na, b, nb, n);
+        std::vector<limb_t> c1 = nttConvolution<NTT_PRIME1>(a, na, b, nb, n);
+        std::vector<limb_t> c2 = nttConvolution<NTT_PRIME2>(a, na, b, nb, n);
+        const dlimb_t m0 = NTT_PRIME0, m1 = NTT_PRIME1, m2 = NTT_PRIME2;
+        const dlimb_t inv01 = powMod(m0, m1 - 2, m1);
+        const dlimb_t inv012 = powMod(m0 % m2 * (m1 % m2) % m2, m2 - 2, m2);
+        dlimb_t carry = 0;
+        for(size_t k = 0; k < na + nb; k++){
+            dlimb_t low = carry, high = 0;
+            if(k < na + nb - 1) {
+                // x = r0 + m0*(t1 + m1*t2), con u = t1 + m1*t2 < m1*m2 < 2^58
+                dlimb_t r0 = c0[k];
+                dlimb_t t1 = (c1[k] + m1 - r0 % m1) % m1 * inv01 % m1;
+                dlimb_t d = (c2[k] + m2 - r0 % m2) % m2;
+                d = (d + m2 - m0 % m2 * t1 % m2) % m2;
+                dlimb_t t2 = d * inv012 % m2;
+                dlimb_t u = t1 + m1 * t2;
+                // m0*u se reparte en dos limbs para no desbordar: m0*u = m0*ul + m0*uh*LIMB_BASE
+                low += r0 + m0 * (u % LIMB_BASE);
+                high = m0 * (u / LIMB_BASE);
+            }
+            r[k] = low % LIMB_BASE;
+            carry = low / LIMB_BASE + high;
+        }
+    }
+
+    // Producto r[0..na+nb) = a * b eligiendo el algoritmo según el tamaño de los operandos
+    // Si un operando es mucho más largo que el otro, se trocea en bloques del tamaño del menor
+    // Si a y b son el mismo rango de limbs se trata como un cuadrado en todos los niveles
+    static void multiplyLimbs(limb_t* r, const limb_t* a, size_t na, const limb_t* b, size_t nb) {
+        if(na < nb) {
+            std::swap(a, b);
+            std::swap(na, nb);
+        }
+        bool square = (a == b && na == nb);
+        if(nb < karatsubaThreshold) {
+            if(square)
+                sqrSchool(r, a, na);
+            else
+                mulSchool(r, a, na, b, nb);
+        } else if(nb >= nttThreshold && na + nb <= NTT_MAX_LENGTH) {
+            mulNTT(r, a, na, b, nb);
+        } else if(2*nb <= na) {
+            std::fill(r, r + na + nb, 0);
+            std::vector<limb_t> partial(2*nb);
+            for(size_t i = 0; i < na; i += nb){
+                size_t len = std::min(nb, na - i);
+                multiplyLimbs(partial.data(), a + i, len, b, nb);
+                addInPlace(r + i, na + nb - i, partial.data(), len + nb);
+            }
+        } else if(nb < toomThreshold) {
+            mulKaratsuba(r, a, na, b, nb);
+        } else if(square || nb > 2*((na + 2) / 3)) {
+            mulToom3(r, a, na, b, nb);
+        } else {
+            mulToom25(r, a, na, b, nb);
+        }
+    }
+
+    // Multiplica en el sitio x[0..n) por un limb pequeño y devuelve el acarreo final
+    static limb_t mulSmallInPlace(limb_t* x, size_t n, limb_t m) {
+        dlimb_t carry = 0;
+        for(size_t i = 0; i < n; i++){
+            dlimb_t current = (dlimb_t)x[i] * m + carry;
+            x[i] = current % LIMB_BASE;
+            carry = current / LIMB_BASE;
+        }
+        return carry;
+    }
+
+    // Divide en el sitio x[0..n) por un limb y devuelve el resto
+    static limb_t divSmallInPlace(limb_t* x, size_t n, limb_t d) {
+        bigdetail::LimbDivisor divisor(d);
+        dlimb_t rem = 0;
+        for(size_t i = n; i-- > 0; )
+            x[i] = divisor.divide(rem * LIMB_BASE + x[i], rem);
+        return rem;
+    }
+
+    // División larga normalizada (algoritmo D de Knuth) sobre limbs
+    // u[0..nu+1) es el dividendo con un limb extra a 0 y se sobrescribe con el resto;
+    // v[0..nv) es el divisor, con nv >= 2, nu >= nv y v[nv-1] != 0. El cociente ocupa
+    // q[0..nu-nv+1). Ambos operandos se escalan para que el limb alto del divisor sea
+    // al menos LIMB_BASE/2, lo que garantiza que la estimación de cada limb del cociente
+    // a partir de los limbs altos se equivoca como mucho en 2
+    static void divKnuth(limb_t* u, size_t nu, limbs_t& v, limb_t* q) {
+        size_t nv = v.size();
+        limb_t scale = LIMB_BASE / ((dlimb_t)v[nv-1] + 1);
+        if(scale > 1) {
+            u[nu] = mulSmallInPlace(u, nu, scale);
+            mulSmallInPlace(v.data(), nv, scale);
+        }
+        const dlimb_t vTop = v[nv-1], vNext = v[nv-2];
+        const bigdetail::LimbDivisor topDivisor(vTop);
+        for(size_t j = nu - nv + 1; j-- > 0; ){
+            // Estimación del limb del cociente a partir de los dos limbs altos del resto
+            dlimb_t num = (dlimb_t)u[j+nv] * LIMB_BASE + u[j+nv-1];
+            dlimb_t rhat;
+            dlimb_t qhat = topDivisor.divide(num, rhat);
+            while(qhat >= LIMB_BASE || qhat * vNext > rhat * LIMB_BASE + u[j+nv-2]) {
+                qhat--;
+                rhat += vTop;
+                if(rhat >= LIMB_BASE)
+                    break;
+            }
+            // u[j..j+nv] -= qhat * v
+            dlimb_t carry = 0;
+            limb_t borrow = 0;
+            for(size_t i = 0; i < nv; i++){
+                dlimb_t p = qhat * v[i] + carry;
+                carry = p / LIMB_BASE;
+                limb_t sub = (limb_t)(p % LIMB_BASE) + borrow;
+                borrow = (u[i+j] < sub);
+                u[i+j] = borrow ? u[i+j] + LIMB_BASE - sub : u[i+j] - sub;
+            }
+            dlimb_t sub = carry + borrow;
+            if(u[j+nv] >= sub) {
+                u[j+nv] -= sub;
+            } else {
+                // La estimación era una unidad demasiado grande: se vuelve a sumar el divisor
+                qhat--;
+                u[j+nv] = 0;
+                addInPlace(u + j, nv, v.data(), nv);
+            }
+            q[j] = qhat;
+        }
+        if(scale > 1)
+            divSmallInPlace(u, nv, scale);
+    }
+
+    // Cociente y resto de u entre v mediante el algoritmo D de Knuth
+    // Cualquiera de los dos punteros de salida puede ser nulo si no se necesita ese valor
+    static void divideKnuth(View u, View v, BigUnsigned* quotient, BigUnsigned* remainder) {
+        if(compareViews(u, v) < 0) {
+            if(remainder) *remainder = BigUnsigned(u);
+            if(quotient) *quotient = BigUnsigned();
+            return;
+        }
+        size_t nu = u.size(), nv = v.size();
+        BigUnsigned q;
+        q.limbs.resize(nu - nv + 1);
+        if(nv == 1) {
+            std::copy(u.data(), u.data() + nu, q.limbs.begin());
+            limb_t rem = divSmallInPlace(q.limbs.data(), nu, v[0]);
+            if(remainder) {
+                remainder->limbs.assign(1, rem);
+                remainder->trim();
+            }
+        } else {
+            // Único buffer de trabajo: empieza siendo el dividendo y termina siendo el resto
+            limbs_t work(nu + 1), vv(v.data(), v.data() + nv);
+            std::copy(u.data(), u.data() + nu, work.begin());
+            divKnuth(work.data(), nu, vv, q.limbs.data());
+            if(remainder) {
+                work.resize(nv);
+                remainder->limbs.swap(work);
+                remainder->trim();
+            }
+        }
+        q.trim();
+        if(quotient) quotient->limbs.swap(q.limbs);
+    }
+
+    // Operaciones sobre vistas, que solo reservan memoria para el resultado
+    static int compareViews(View a, View b) {
+        return compareLimbs(a.data(), a.size(), b.data(), b.size());
+    }
+
+    static BigUnsigned addViews(View a, View b) {
+        if(a.size() < b.size())
+            std::swap(a, b);
+        // El limb extra solo se añade si hay acarreo, para no salir del buffer interno sin necesidad
+        BigUnsigned result(a);
+        if(addInPlace(result.limbs.data(), a.size(), b.data(), b.size()))
+            result.limbs.push_back(1);
+        return result;
+    }
+
+    // a - b; lanza excepción si b > a, porque el resultado no sería un BigUnsigned
+    static BigUnsigned subtractViews(View a, View b) {
+        if(b.size() > a.size())
+            throw BigNumberException();
+        BigUnsigned result(a);
+        if(subInPlace(result.limbs.data(), a.size(), b.data(), b.size()))
+            throw BigNumberException();
+        result.trim();
+        return result;
+    }
+
+    // Si ambas vistas son el mismo tramo, multiplyLimbs usa las variantes de cuadrado
+    static BigUnsigned multiplyViews(View a, View b) {
+        BigUnsigned result;
+        if(a.empty() || b.empty())
+            return result;
+        result.limbs.resize(a.size() + b.size());
+        multiplyLimbs(result.limbs.data(), a.data(), a.size(), b.data(), b.size());
+        result.trim();
+        return result;
+    }
+
+    // high * LIMB_BASE^k + low, con low < LIMB_BASE^k: los limbs se colocan sin sumar
+    static BigUnsigned joinViews(View high, size_t k, View low) {
+        if(high.empty())
+            return BigUnsigned(low);
+        BigUnsigned result;
+        result.limbs.reserve(k + high.size());
+        result.limbs.assign(low.data(), low.data() + low.size());
+        result.limbs.resize(k);
+        result.limbs.append(high.data(), high.data() + high.size());
+        return result;
+    }
+
+    // a * m * LIMB_BASE^k, con m un limb
+    static BigUnsigned scaleViews(View a, limb_t m, size_t k) {
+        BigUnsigned result;
+        result.limbs.reserve(k + a.size() + 1);
+        result.limbs.resize(k);
+        result.limbs.append(a.data(), a.data() + a.size());
+        result.limbs.push_back(mulSmallInPlace(result.limbs.data() + k, a.size(), m));
+        result.trim();
+        return result;
+    }
+
+    // *this += b sobre el propio buffer, que solo crece si hace falta
+    void addView(View b) {
+        if(limbs.size() < b.size())
+            limbs.resize(b.size());
+        if(addInPlace(limbs.data(), limbs.size(), b.data(), b.size()))
+            limbs.push_back(1);
+    }
+
+    // *this -= b * LIMB_BASE^k sobre el propio buffer
+    // Si el resultado fuera negativo se deshace la resta y se lanza excepción
+    void subtractView(View b, size_t k = 0) {
+        if(b.empty())
+            return;
+        if(b.size() + k > limbs.size())
+            throw BigNumberException();
+        if(subInPlace(limbs.data() + k, limbs.size() - k, b.data(), b.size())) {
+            addInPlace(limbs.data() + k, limbs.size() - k, b.data(), b.size());
+            throw BigNumberException();
+        }
+        trim();
+    }
+
+    // Camino rápido para números pequeños: si el número ocupa como mucho dos limbs su valor
+    // (menor que LIMB_BASE^2 <= 2^60) se guarda en out como entero nativo y se devuelve true
+    bool smallWord(dlimb_t& out) const {
+        switch(limbs.size()) {
+            case 0: out = 0; return true;
+            case 1: out = limbs[0]; return true;
+            case 2: out = (dlimb_t)limbs[1] * LIMB_BASE + limbs[0]; return true;
+            default: return false;
+        }
+    }
+
+    // Valor de los limbs n-1 y n-2 (los que falten cuentan como 0), menor que 2^60
+    unsigned long long leadingPair(size_t n) const {
+        unsigned long long high = (n - 1 < limbs.size()) ? limbs[n-1] : 0;
+        unsigned long long low = (n - 2 < limbs.size()) ? limbs[n-2] : 0;
+        return high * LIMB_BASE + low;
+    }
+
+    // Inverso de x módulo LIMB_BASE (x debe ser coprimo con LIMB_BASE), por Euclides extendido
+    static limb_t inverseModLimb(limb_t x) {
+        long long r0 = LIMB_BASE, r1 = x, t0 = 0, t1 = 1;
+        while(r1 != 0) {
+            long long q = r0 / r1, t;
+            t = r0 - q*r1; r0 = r1; r1 = t;
+            t = t0 - q*t1; t0 = t1; t1 = t;
+        }
+        return (t0 < 0) ? t0 + LIMB_BASE : t0;
+    }
+
+    // Máximo común divisor binario sobre enteros de 64 bits (algoritmo de Stein)
+    static unsigned long long binaryGcd(unsigned long long u, unsigned long long v) {
+        if(u == 0) return v;
+        if(v == 0) return u;
+        int shift = __builtin_ctzll(u | v);
+        u >>= __builtin_ctzll(u);
+        while(v != 0) {
+            v >>= __builtin_ctzll(v);
+            if(u > v)
+                std::swap(u, v);
+            v -= u;
+        }
+        return u << shift;
+    }
+
+    // m = m * h para matrices 2x2 guardadas por filas, [m0 m1; m2 m3]
+    static void matrixMul(BigUnsigned* m, const BigUnsigned* h) {
+        BigUnsigned t0 = m[0] * h[0] + m[1] * h[2], t1 = m[0] * h[1] + m[1] * h[3];
+        BigUnsigned t2 = m[2] * h[0] + m[3] * h[2], t3 = m[2] * h[1] + m[3] * h[3];
+        m[0] = std::move(t0);
+        m[1] = std::move(t1);
+        m[2] = std::move(t2);
+        m[3] = std::move(t3);
+    }
+
+    // Un paso del algoritmo de Euclides sobre a y b, con b > 0 (si a < b se intercambian antes)
+    // Se usa el algoritmo de Lehmer: se simula el algoritmo de Euclides sobre los 60 bits altos
+    // (dos limbs) de ambos números y la secuencia de cocientes acumulada en la matriz [A B; C D]
+    // se aplica de una vez a los números completos, sustituyendo decenas de divisiones largas por
+    // cuatro productos por un entero de 64 bits. Si la simulación no avanza se hace una división.
+    // Si m no es nulo, los cocientes aplicados se acumulan en la matriz m, de modo que
+    // (a; b) = M (a'; b'); negative lleva el signo de su determinante
+    static void euclidStep(BigUnsigned& a, BigUnsigned& b, BigUnsigned* m, bool& negative) {
+        if(a < b) {
+            std::swap(a.limbs, b.limbs);
+            if(m) {
+                std::swap(m[0].limbs, m[1].limbs);
+                std::swap(m[2].limbs, m[3].limbs);
+            }
+            negative = !negative;
+        }
+        size_t n = a.limbs.size();
+        long long ah = a.leadingPair(n), bh = b.leadingPair(n);
+        long long A = 1, B = 0, C = 0, D = 1;
+        bool odd = false;
+        // Algoritmo L de Knuth: se avanza mientras los cocientes de ambos extremos coinciden
+        while(bh + C != 0 && bh + D != 0) {
+            long long q = (ah + A) / (bh + C);
+            if(q != (ah + B) / (bh + D))
+                break;
+            long long t = A - q*C; A = C; C = t;
+            t = B - q*D; B = D; D = t;
+            t = ah - q*bh; ah = bh; bh = t;
+            odd = !odd;
+        }
+        if(B == 0) {
+            BigUnsigned q, r;
+            a.divideInto(b, m ? &q : nullptr, &r);
+            std::swap(a.limbs, b.limbs);
+            std::swap(b.limbs, r.limbs);
+            if(m) {
+                const BigUnsigned h[4] = { q, fromWord(1), fromWord(1), BigUnsigned() };
+                matrixMul(m, h);
+            }
+            negative = !negative;
+        } else {
+            // A y B (y también C y D) tienen signos opuestos o son 0, por lo que cada
+            // combinación lineal es una resta de dos productos no negativos
+            BigUnsigned na = (B < 0) ? a * fromWord(A) - b * fromWord(-B)
+                                     : b * fromWord(B) - a * fromWord(-A);
+            BigUnsigned nb = (D < 0) ? a * fromWord(C) - b * fromWord(-D)
+                                     : b * fromWord(D) - a * fromWord(-C);
+            std::swap(a.limbs, na.limbs);
+            std::swap(b.limbs, nb.limbs);
+            if(m) {
+                // La inversa de [A B; C D] es [|D| |B|; |C| |A|] salvo el signo del determinante
+                const BigUnsigned h[4] = { fromWord(D < 0 ? -D : D), fromWord(B < 0 ? -B : B),
+                                           fromWord(C < 0 ? -C : C), fromWord(A < 0 ? -A : A) };
+                matrixMul(m, h);
+            }
+            if(odd)
+                negative = !negative;
+        }
+    }
+
+    // Reduce a y b con el medio mcd de sus limbs a partir del p-ésimo
+    // Los cocientes H obtenidos de la parte alta se aplican a los números completos de una vez,
+    // con la multiplicación rápida: (a'; b') = H^-1 (a; b) = ±(h3*a - h1*b; h0*b - h2*a). Si alguno
+    // de los dos restos sale negativo, no todos los cocientes valían para los números completos:
+    // la matriz se descarta, a y b no cambian y se devuelve false
+    static bool reduceHigh(BigUnsigned& a, BigUnsigned& b, size_t p, BigUnsigned* m, bool& negative) {
+        BigUnsigned ah(a.view().high(p)), bh(b.view().high(p));
+        BigUnsigned h[4];
+        bool hNegative;
+        halfGcd(ah, bh, h, hNegative);
+        if(h[1].isZero() && h[2].isZero())
+            return true;
+        BigUnsigned x = h[3] * a, xs = h[1] * b, y = h[0] * b, ys = h[2] * a;
+        if(hNegative) {
+            std::swap(x.limbs, xs.limbs);
+            std::swap(y.limbs, ys.limbs);
+        }
+        if(x < xs || y < ys)
+            return false;
+        x.subtractView(xs.view());
+        y.subtractView(ys.view());
+        std::swap(a.limbs, x.limbs);
+        std::swap(b.limbs, y.limbs);
+        if(m)
+            matrixMul(m, h);
+        negative = (negative != hNegative);
+        return true;
+    }
+
+    // Medio mcd: reduce a y b, con n limbs el mayor, con pasos del algoritmo de Euclides hasta
+    // que el menor tiene como mucho s = n/2 + HGCD_MARGIN limbs, y deja en m (si no es nulo) la
+    // matriz de los cocientes aplicados: (a; b) = M (a'; b'), con determinante -1 si negative.
+    // Desde gcdThreshold limbs, los cocientes se obtienen recursivamente de las partes altas, que
+    // los determinan mientras los restos sigan por encima de las entradas de la matriz: la mitad
+    // alta lleva el resto a unos 3n/4 limbs y una segunda parte alta de unos n/2 limbs, hasta s.
+    // El coste es O(M(n) log n) en lugar del O(n^2) de los pasos de Lehmer
+    static void halfGcd(BigUnsigned& a, BigUnsigned& b, BigUnsigned* m, bool& negative) {
+        negative = false;
+        if(m) {
+            m[0] = m[3] = fromWord(1);
+            m[1] = m[2] = BigUnsigned();
+        }
+        if(a < b) {
+            std::swap(a.limbs, b.limbs);
+            if(m) {
+                std::swap(m[0].limbs, m[1].limbs);
+                std::swap(m[2].limbs, m[3].limbs);
+            }
+            negative = true;
+        }
+        size_t n = a.limbs.size(), s = n / 2 + HGCD_MARGIN;
+        if(b.limbs.size() <= s)
+            return;
+        if(n >= gcdThreshold) {
+            reduceHigh(a, b, n / 2, m, negative);
+            // Con a de n2 limbs, la parte alta desde p2 = n - n2 (redondeando n a par) reduce el
+            // resto hasta unos (n2 + p2)/2 = n/2 limbs; si la primera reducción no avanzó, p2
+            // sería 0 y se sigue paso a paso
+            size_t n2 = a.limbs.size();
+            if(b.limbs.size() > s && n2 < 2*(n / 2))
+                reduceHigh(a, b, 2*(n / 2) - n2, m, negative);
+        }
+        while(b.limbs.size() > s)
+            euclidStep(a, b, m, negative);
+    }
+
+    // Paso 2n/1n de Burnikel-Ziegler: a < b * LIMB_BASE^n, con b normalizado de n limbs
+    // Si n es impar o pequeño se recurre al algoritmo de Knuth
+    // Los operandos son vistas, así que las mitades se pasan a la recursión sin copiarlas
+    static void div2n1n(View a, View b, size_t n, BigUnsigned& q, BigUnsigned& r) {
+        if(n % 2 != 0 || n < bzThreshold) {
+            divideKnuth(a, b, &q, &r);
+            return;
+        }
+        size_t h = n / 2;
+        BigUnsigned q1, r1, q0;
+        // Se dividen los 3h limbs altos y después el resto junto con los h limbs bajos
+        div3n2n(a.high(h), b, h, q1, r1);
+        div3n2n(joinViews(r1.view(), h, a.low(h)).view(), b, h, q0, r);
+        q = joinViews(q1.view(), h, q0.view());
+    }
+
+    // Paso 3n/2n de Burnikel-Ziegler: a tiene 3h limbs, b tiene 2h limbs (b = b1*β^h + b2)
+    // y a < b * β^h. El cociente se estima dividiendo los 2h limbs altos de a entre b1 y se
+    // corrige como mucho dos veces
+    static void div3n2n(View a, View b, size_t h, BigUnsigned& q, BigUnsigned& r) {
+        View a12 = a.high(h), b1 = b.high(h);
+        BigUnsigned r1;
+        if(compareViews(a.high(2*h), b1) < 0) {
+            div2n1n(a12, b1, h, q, r1);
+        } else {
+            // El cociente estimado es β^h - 1 y r1 = a12 - q*b1 = a12 + b1 - b1*β^h
+            q.limbs.assign(h, LIMB_BASE - 1);
+            r1 = addViews(a12, b1);
+            r1.subtractView(b1, h);
+        }
+        BigUnsigned d = multiplyViews(q.view(), b.low(h));
+        BigUnsigned x = joinViews(r1.view(), h, a.low(h));
+        const limb_t one = 1;
+        while(x < d) {
+            x.addView(b);
+            q.subtractView(View(&one, 1));
+        }
+        x.subtractView(d.view());
+        r = std::move(x);
+    }
+
+    // División de Burnikel-Ziegler para divisores grandes
+    // El divisor se escala para normalizar su limb alto y se rellena con limbs nulos por abajo
+    // hasta un tamaño de bloque m*2^k (m < bzThreshold), de modo que la recursión siempre
+    // parte en mitades exactas. El dividendo se procesa en bloques de ese tamaño
+    void divideBZ(const BigUnsigned& divisor, BigUnsigned* quotient, BigUnsigned* remainder) const {
+        size_t n = divisor.limbs.size(), k = 0;
+        while((n >> k) >= bzThreshold)
+            k++;
+        size_t blockLen = ((n + (size_t(1) << k) - 1) >> k) << k;
+        size_t shift = blockLen - n;
+        limb_t scale = LIMB_BASE / ((dlimb_t)divisor.limbs.back() + 1);
+        BigUnsigned b = scaleViews(divisor.view(), scale, shift);
+        BigUnsigned a = scaleViews(view(), scale, shift);
+        // El bloque alto tiene menos de blockLen limbs, por lo que es menor que b
+        size_t t = a.limbs.size() / blockLen + 1;
+        BigUnsigned z(a.view().high((t-1) * blockLen)), qi, ri;
+        BigUnsigned q;
+        q.limbs.assign((t-1) * blockLen, 0);
+        for(size_t i = t-1; i-- > 0; ){
+            z = joinViews(z.view(), blockLen, a.view().high(i * blockLen).low(blockLen));
+            div2n1n(z.view(), b.view(), blockLen, qi, ri);
+            z.limbs.swap(ri.limbs);
+            std::copy(qi.limbs.begin(), qi.limbs.end(), q.limbs.begin() + i * blockLen);
+        }
+        q.trim();
+        if(remainder) {
+            *remainder = BigUnsigned(z.view().high(shift));
+            divSmallInPlace(remainder->limbs.data(), remainder->limbs.size(), scale);
+            remainder->trim();
+        }
+        if(quotient) quotient->limbs.swap(q.limbs);
+    }
+
+    // Calcula el cociente y el resto de *this entre divisor, que no puede ser 0
+    // Con divisor y cociente grandes se usa Burnikel-Ziegler y en otro caso Knuth
+    // Si ambos operandos caben en una palabra se divide directamente con el hardware
+    void divideInto(const BigUnsigned& divisor, BigUnsigned* quotient, BigUnsigned* remainder) const {
+        dlimb_t x, y;
+        if(smallWord(x) && divisor.smallWord(y)) {
+            if(quotient) *quotient = fromWord(x / y);
+            if(remainder) *remainder = fromWord(x % y);
+            return;
+        }
+        size_t nv = divisor.limbs.size();
+        if(nv >= bzThreshold && limbs.size() >= nv + bzThreshold)
+            divideBZ(divisor, quotient, remainder);
+        else
+            divideKnuth(view(), divisor.view(), quotient, remainder);
+    }
+
+    // Número de limbs de la base de origen por debajo del cual la conversión entre bases
+    // se hace con el esquema de Horner
+    static const size_t RADIX_THRESHOLD = 32;
+
+    // Valor en esta base de src[0..n), limbs en base fromBase (<= 2^30), por el esquema de
+    // Horner: cuadrático, pero sin sobrecoste para pocos limbs
+    static BigUnsigned radixHorner(const limb_t* src, size_t n, dlimb_t fromBase) {
+        BigUnsigned r;
+        for(size_t i = n; i-- > 0; ){
+            dlimb_t carry = src[i];
+            for(size_t k = 0; k < r.limbs.size(); k++){
+                dlimb_t current = r.limbs[k] * fromBase + carry;
+                r.limbs[k] = current % LIMB_BASE;
+                carry = current / LIMB_BASE;
+            }
+            while(carry != 0) {
+                r.limbs.push_back(carry % LIMB_BASE);
+                carry /= LIMB_BASE;
+            }
+        }
+        return r;
+    }
+
+    // Valor en esta base de src[0..n), limbs en base fromBase, por divide y vencerás
+    // Con k = RADIX_THRESHOLD*2^j < n <= 2k el número es alto * fromBase^k + bajo: se convierte
+    // cada mitad por separado y se combinan con una multiplicación, de modo que el coste lo
+    // dominan las multiplicaciones rápidas. powers[j] = fromBase^(RADIX_THRESHOLD*2^j) en esta base
+    static BigUnsigned radixConvert(const limb_t* src, size_t n, dlimb_t fromBase,
+                                    const std::vector<BigUnsigned>& powers) {
+        n = normLen(src, n);
+        if(n <= RADIX_THRESHOLD)
+            return radixHorner(src, n, fromBase);
+        size_t j = 0;
+        while((RADIX_THRESHOLD << (j + 1)) < n)
+            j++;
+        size_t k = RADIX_THRESHOLD << j;
+        BigUnsigned result = radixConvert(src + k, n - k, fromBase, powers) * powers[j];
+        result += radixConvert(src, k, fromBase, powers);
+        return result;
+    }
+
+    // Tabla de potencias LIMB_BASE de Other elevado a RADIX_THRESHOLD*2^j, expresadas en esta
+    // base, con las entradas necesarias para convertir n limbs. Cada potencia es el cuadrado de
+    // la anterior; hay una tabla por base de origen y se conserva entre conversiones
+    template <unsigned char Other>
+    static const std::vector<BigUnsigned>& radixPowers(size_t n) {
+        static std::vector<BigUnsigned> powers;
+        if(powers.empty()) {
+            std::vector<limb_t> first(RADIX_THRESHOLD + 1, 0);
+            first.back() = 1;
+            powers.push_back(radixHorner(first.data(), first.size(), BigUnsigned<Other>::LIMB_BASE));
+        }
+        while((RADIX_THRESHOLD << powers.size()) < n) {
+            BigUnsigned square = powers.back() * powers.back();
+            powers.push_back(std::move(square));
+        }
+        return powers;
+    }
+
 public:
     // Constructor a partir de una cadena (sin sufijo)
     BigUnsigned(const char* str) {
         std::string s(str);
-        // Recorremos la cadena desde el final hasta el principio
-        for(auto it = s.rbegin(); it != s.rend(); ++it)
-            digits.push_back(charToDigit(*it));
+        limbs.reserve(s.size() / LIMB_DIGITS + 1);
+        // Se agrupan los dígitos de LIMB_DIGITS en LIMB_DIGITS empezando por el final de la cadena
+        size_t end = s.size();
+        while(end > 0) {
+            size_t begin = (end > LIMB_DIGITS) ? end - LIMB_DIGITS : 0;
+            limb_t value = 0;
+            for(size_t i = begin; i < end; i++)
+                value = value * Base + charToDigit(s[i]);
+            limbs.push_back(value);
+            end = begin;
+        }
+        trim();
     }
 
     // Constructor por defecto, inicializa el número en 0
-    BigUnsigned() { digits.push_back(0); }
+    BigUnsigned() {}
+
+    // Constructor de copia
+    BigUnsigned(const BigUnsigned& other) : limbs(other.limbs) {}
+
+    // Constructor de movimiento: se queda con el buffer de other, que pasa a valer 0
+    BigUnsigned(BigUnsigned&& other) noexcept : limbs(std::move(other.limbs)) {}
+
+    // Conversión desde cualquier otra base que no sea, como esta, potencia de dos
+    // (por ejemplo BigUnsigned<10> a BigUnsigned<16> o al revés), en O(M(n) log n) con
+    // divide y vencerás sobre los limbs de other (ver radixConvert)
+    template <unsigned char Other>
+    explicit BigUnsigned(const BigUnsigned<Other>& other,
+                         typename std::enable_if<Other != Base && !(bigdetail::isPowerOfTwo(Base) &&
+                                                 bigdetail::isPowerOfTwo(Other))>::type* = nullptr)
+        : BigUnsigned(radixConvert(other.limbs.data(), other.limbs.size(), BigUnsigned<Other>::LIMB_BASE,
+                                   radixPowers<Other>(other.limbs.size()))) {}
+
+    // Conversión desde otra base potencia de dos (por ejemplo BigUnsigned<8> a BigUnsigned<16>)
+    // Los limbs de ambas bases son grupos de bits del mismo número binario, así que basta con
+    // reagruparlos en tiempo lineal: se van acumulando los bits de other y se extraen en
+    // grupos de LIMB_BITS. Si los limbs tienen el mismo ancho (2, 4, 8 y 32) se copian sin más
+    template <unsigned char Other>
+    explicit BigUnsigned(const BigUnsigned<Other>& other,
+                         typename std::enable_if<Other != Base && bigdetail::isPowerOfTwo(Base) &&
+                                                 bigdetail::isPowerOfTwo(Other)>::type* = nullptr) {
+        const unsigned fromBits = BigUnsigned<Other>::LIMB_BITS;
+        const size_t n = other.limbs.size();
+        if(fromBits == LIMB_BITS) {
+            limbs.assign(other.limbs.data(), other.limbs.data() + n);
+            return;
+        }
+        limbs.reserve((n * fromBits) / LIMB_BITS + 1);
+        // Como mucho quedan LIMB_BITS-1 bits pendientes más fromBits nuevos, menos de 64
+        dlimb_t pending = 0;
+        unsigned bits = 0;
+        for(size_t i = 0; i < n; i++){
+            pending |= (dlimb_t)other.limbs[i] << bits;
+            bits += fromBits;
+            while(bits >= LIMB_BITS) {
+                limbs.push_back(static_cast<limb_t>(pending & (LIMB_BASE - 1)));
+                pending >>= LIMB_BITS;
+                bits -= LIMB_BITS;
+            }
+        }
+        if(pending != 0)
+            limbs.push_back(static_cast<limb_t>(pending));
+        trim();
+    }
 
     // Operador de asignación.
     BigUnsigned& operator=(const BigUnsigned& other) {
         if(this != &other)
-            digits = other.digits;
+            limbs = other.limbs;
         return *this;
     }
 
+    // Asignación por movimiento
+    BigUnsigned& operator=(BigUnsigned&& other) noexcept {
+        limbs = std::move(other.limbs);
+        return *this;
+    }
+
+    // Ajusta los umbrales de la multiplicación (en limbs del operando menor)
+    // Karatsuba necesita al menos 2 limbs y Toom-3 al menos 3 para poder partir los operandos
+    static void setMultiplyThresholds(size_t karatsuba, size_t toom, size_t ntt) {
+        karatsubaThreshold = std::max<size_t>(karatsuba, 2);
+        toomThreshold = std::max<size_t>(toom, 3);
+        nttThreshold = ntt;
+    }
+
+    // Devuelve los umbrales actuales de la multiplicación, en el orden de setMultiplyThresholds
+    static void getMultiplyThresholds(size_t& karatsuba, size_t& toom, size_t& ntt) {
+        karatsuba = karatsubaThreshold;
+        toom = toomThreshold;
+        ntt = nttThreshold;
+    }
+
+    // Ajusta el umbral de la división de Burnikel-Ziegler (en limbs del divisor y del cociente)
+    static void setDivideThreshold(size_t bz) {
+        bzThreshold = std::max<size_t>(bz, 2);
+    }
+
+    // Ajusta el umbral del medio mcd (en limbs del mayor operando)
+    // Hacen falta al menos 4 limbs para que la parte alta sea menor que el número completo
+    static void setGcdThreshold(size_t threshold) {
+        gcdThreshold = std::max<size_t>(threshold, 4);
+    }
+
+    // Indica si el número es 0
+    bool isZero() const {
+        return limbs.empty();
+    }
+
     // Operador suma
-    BigUnsigned operator+(const BigUnsigned& other) const {
-        BigUnsigned result;
-        result.digits.clear(); // Se limpia el vector de dígitos del resultado
-        unsigned char carry = 0;
-        // Se itera hasta el tamaño máximo entre ambos números
-        size_t n = std::max(digits.size(), other.digits.size());
-        for(size_t i = 0; i < n; i++){
-            unsigned char d1 = (i < digits.size()) ? digits[i] : 0;
-            unsigned char d2 = (i < other.digits.size()) ? other.digits[i] : 0;
-            unsigned char sum = d1 + d2 + carry;
-            carry = sum / Base;
-            result.digits.push_back(sum % Base);
-        }
-        if(carry)
-            result.digits.push_back(carry);
-        return result;
+    // Dos operandos de hasta dos limbs se suman como enteros nativos (la suma es menor que 2^61)
+    BigUnsigned operator+(const BigUnsigned& other) const & {
+        dlimb_t x, y;
+        if(smallWord(x) && other.smallWord(y))
+            return fromWord(x + y);
+        return addViews(view(), other.view());
     }
 
-    // Operador resta (se asume que *this es mayor o igual que other)
-    BigUnsigned operator-(const BigUnsigned& other) const {
-        BigUnsigned result;
-        result.digits.clear();
-        unsigned char borrow = 0;
-        for(size_t i = 0; i < digits.size(); i++){
-            int d1 = digits[i];
-            int d2 = (i < other.digits.size()) ? other.digits[i] : 0;
-            int diff = d1 - d2 - borrow;
-            if(diff < 0) { diff += Base; borrow = 1; }
-            else borrow = 0;
-            result.digits.push_back(diff);
-        }
-        // Se eliminan los ceros a la izquierda
-        while(result.digits.size() > 1 && result.digits.back() == 0)
-            result.digits.pop_back();
-        return result;
+    // Si el operando izquierdo es un temporal se suma sobre su propio buffer
+    BigUnsigned operator+(const BigUnsigned& other) && {
+        *this += other;
+        return std::move(*this);
+    }
+
+    // Operador resta
+    // Si other es mayor que *this el resultado no es representable y se lanza excepción
+    BigUnsigned operator-(const BigUnsigned& other) const & {
+        dlimb_t x, y;
+        if(smallWord(x) && other.smallWord(y)) {
+            if(x < y)
+                throw BigNumberException();
+            return fromWord(x - y);
+        }
+        return subtractViews(view(), other.view());
+    }
+
+    BigUnsigned operator-(const BigUnsigned& other) && {
+        *this -= other;
+        return std::move(*this);
+    }
+
+    // Suma en el sitio: se aprovecha la capacidad ya reservada y solo se crece si hay acarreo
+    BigUnsigned& operator+=(const BigUnsigned& other) {
+        dlimb_t x, y;
+        if(smallWord(x) && other.smallWord(y))
+            return *this = fromWord(x + y);
+        addView(other.view());
+        return *this;
+    }
+
+    // Resta en el sitio; si other es mayor que *this se lanza excepción sin modificar *this
+    BigUnsigned& operator-=(const BigUnsigned& other) {
+        subtractView(other.view());
+        return *this;
+    }
+
+    // El producto y la división no se pueden calcular sobre sus operandos, así que se calcula
+    // el resultado aparte y se mueve a *this, liberando el buffer anterior
+    BigUnsigned& operator*=(const BigUnsigned& other) {
+        return *this = (*this) * other;
+    }
+
+    BigUnsigned& operator/=(const BigUnsigned& other) {
+        return *this = (*this) / other;
+    }
+
+    BigUnsigned& operator%=(const BigUnsigned& other) {
+        return *this = (*this) % other;
     }
 
     // Operador multiplicación
+    // Se delega en multiplyLimbs, que elige el algoritmo según el tamaño de los operandos
+    // Si ambos operandos son el mismo objeto (x*x) se usan las variantes de cuadrado
+    // Con operandos de hasta dos limbs se multiplica en 64 bits comprobando el desbordamiento,
+    // y solo si el producto no cabe se pasa a los algoritmos sobre limbs
     BigUnsigned operator*(const BigUnsigned& other) const {
-        BigUnsigned result;
-        // Se asigna un vector de tamaño adecuado, inicializado a 0
-        result.digits = std::vector<unsigned char>(digits.size() + other.digits.size(), 0);
-        for(size_t i = 0; i < digits.size(); i++){
-            unsigned char carry = 0;
-            for(size_t j = 0; j < other.digits.size() || carry; j++){
-                unsigned int current = result.digits[i+j] +
-                    digits[i] * (j < other.digits.size() ? other.digits[j] : 0) + carry;
-                result.digits[i+j] = current % Base;
-                carry = current / Base;
-            }
-        }
-        while(result.digits.size() > 1 && result.digits.back() == 0)
-            result.digits.pop_back();
-        return result;
+        dlimb_t x, y, p;
+        if(smallWord(x) && other.smallWord(y) && !__builtin_mul_overflow(x, y, &p))
+            return fromWord(p);
+        return multiplyViews(view(), other.view());
     }
 
-    // Operador división (implementación del algoritmo de división larga)
+    // Cuadrado del número
+    BigUnsigned square() const {
+        return (*this) * (*this);
+    }
+
+    // Operador división (Knuth o Burnikel-Ziegler, ver divideInto)
     BigUnsigned operator/(const BigUnsigned& other) const {
-        if(other == BigUnsigned(0))
+        if(other.isZero())
             throw BigNumberDivisionByZero();
-        BigUnsigned dividend(*this), divisor(other), quotient, current;
-        quotient.digits.clear();
-        current.digits.clear();
-        for(int i = dividend.digits.size()-1; i >= 0; i--){
-            // Se inserta el siguiente dígito en current
-            current.digits.insert(current.digits.begin(), dividend.digits[i]);
-            unsigned char count = 0;
-            // Se resta divisor de current hasta que current < divisor
-            while(!(current < divisor)){
-                current = current - divisor;
-                count++;
-            }
-            quotient.digits.insert(quotient.digits.begin(), count);
-        }
-        while(quotient.digits.size() > 1 && quotient.digits.back() == 0)
-            quotient.digits.pop_back();
+        BigUnsigned quotient;
+        divideInto(other, &quotient, nullptr);
         return quotient;
     }
 
+    // Operador módulo, el resto que deja la división
+    BigUnsigned operator%(const BigUnsigned& other) const {
+        if(other.isZero())
+            throw BigNumberDivisionByZero();
+        BigUnsigned remainder;
+        divideInto(other, nullptr, &remainder);
+        return remainder;
+    }
+
+    // Cociente y resto de una sola pasada (first es el cociente y second el resto)
+    std::pair<BigUnsigned, BigUnsigned> divmod(const BigUnsigned& other) const {
+        if(other.isZero())
+            throw BigNumberDivisionByZero();
+        std::pair<BigUnsigned, BigUnsigned> result;
+        divideInto(other, &result.first, &result.second);
+        return result;
+    }
+
+    // Comparación con precisión completa: devuelve -1, 0 o 1 si *this es menor, igual o mayor
+    // Como no hay limbs nulos en la parte alta, la longitud decide casi siempre y en otro caso
+    // se comparan los limbs desde el más significativo hasta el primero distinto
+    int compare(const BigUnsigned& other) const {
+        return compareLimbs(limbs.data(), limbs.size(), other.limbs.data(), other.limbs.size());
+    }
+
     // Operador de comparación, se utiliza en la división
     bool operator<(const BigUnsigned& other) const {
-        if(digits.size() != other.digits.size())
-            return digits.size() < other.digits.size();
-        for(int i = digits.size()-1; i >= 0; i--){
-            if(digits[i] != other.digits[i])
-                return digits[i] < other.digits[i];
+        return compare(other) < 0;
+    }
+
+    // Indica si el número es impar
+    // Si la base es par, LIMB_BASE también lo es y basta con mirar el limb bajo;
+    // si es impar, la paridad es la de la suma de todos los limbs
+    bool isOdd() const {
+        if(Base % 2 == 0)
+            return !limbs.empty() && (limbs[0] & 1);
+        limb_t parity = 0;
+        for(size_t i = 0; i < limbs.size(); i++)
+            parity ^= limbs[i] & 1;
+        return parity;
+    }
+
+    // Guarda el valor en out si cabe en 64 bits. Devuelve false si no cabe
+    bool toWord(unsigned long long& out) const {
+        out = 0;
+        for(size_t i = limbs.size(); i-- > 0; ){
+            if(out > (~0ULL - limbs[i]) / LIMB_BASE)
+                return false;
+            out = out * LIMB_BASE + limbs[i];
+        }
+        return true;
+    }
+
+    // División exacta: *this / divisor sabiendo que el resto es 0 (algoritmo de Jebelean)
+    // Se trabaja desde el limb menos significativo: si v0 es invertible módulo LIMB_BASE, cada
+    // limb del cociente es q_i = u_i * v0^-1 mod LIMB_BASE y solo hace falta restar q_i*v sobre
+    // los limbs que aún forman parte del cociente, sin estimaciones ni correcciones.
+    // Antes se eliminan del divisor (y del dividendo) los limbs nulos bajos y los factores primos
+    // que comparte con la base, que son los que impiden invertir v0
+    BigUnsigned divexact(const BigUnsigned& divisor) const {
+        if(divisor.isZero())
+            throw BigNumberDivisionByZero();
+        if(isZero())
+            return BigUnsigned();
+        size_t zeros = 0;
+        while(divisor.limbs[zeros] == 0)
+            zeros++;
+        limbs_t u(limbs.begin() + std::min(zeros, limbs.size()), limbs.end());
+        limbs_t v(divisor.limbs.begin() + zeros, divisor.limbs.end());
+        for(limb_t p = 2; p <= Base; p++){
+            if(Base % p != 0)
+                continue;
+            // La mayor potencia de p que divide a v0 y a LIMB_BASE también divide a v y a u
+            while(v[0] % p == 0) {
+                limb_t pe = p;
+                while(LIMB_BASE % (pe * p) == 0 && v[0] % (pe * p) == 0)
+                    pe *= p;
+                divSmallInPlace(u.data(), u.size(), pe);
+                divSmallInPlace(v.data(), v.size(), pe);
+                u.resize(normLen(u.data(), u.size()));
+                v.resize(normLen(v.data(), v.size()));
+            }
         }
-        return false;
+        BigUnsigned q;
+        if(v.size() == 1) {
+            divSmallInPlace(u.data(), u.size(), v[0]);
+            q.limbs.swap(u);
+            q.trim();
+            return q;
+        }
+        if(u.size() < v.size())
+            return q;
+        size_t qn = u.size() - v.size() + 1;
+        limb_t inv = inverseModLimb(v[0]);
+        q.limbs.resize(qn);
+        for(size_t i = 0; i < qn; i++){
+            limb_t qi = (dlimb_t)u[i] * inv % LIMB_BASE;
+            q.limbs[i] = qi;
+            // u[i..qn) -= qi * v, truncado a los limbs que quedan por calcular
+            size_t len = std::min(v.size(), qn - i);
+            dlimb_t carry = 0;
+            limb_t borrow = 0;
+            for(size_t j = 0; j < len; j++){
+                dlimb_t p = (dlimb_t)qi * v[j] + carry;
+                carry = p / LIMB_BASE;
+                limb_t sub = (limb_t)(p % LIMB_BASE) + borrow;
+                borrow = (u[i+j] < sub);
+                u[i+j] = borrow ? u[i+j] + LIMB_BASE - sub : u[i+j] - sub;
+            }
+            // El acarreo y el préstamo pendientes se propagan hacia los limbs altos
+            dlimb_t rest = carry + borrow;
+            for(size_t j = i + len; rest != 0 && j < qn; j++){
+                limb_t sub = rest % LIMB_BASE;
+                rest /= LIMB_BASE;
+                if(u[j] < sub) {
+                    u[j] = u[j] + LIMB_BASE - sub;
+                    rest++;
+                } else {
+                    u[j] -= sub;
+                }
+            }
+        }
+        q.trim();
+        return q;
+    }
+
+    // Construye un BigUnsigned a partir de un entero de 64 bits
+    static BigUnsigned fromWord(unsigned long long w) {
+        BigUnsigned result;
+        while(w != 0) {
+            result.limbs.push_back(w % LIMB_BASE);
+            w /= LIMB_BASE;
+        }
+        return result;
+    }
+
+    // Máximo común divisor
+    // Con operandos grandes, el medio mcd (halfGcd) reduce el mayor a la mitad de limbs con
+    // la multiplicación rápida; por debajo de gcdThreshold se dan pasos de Lehmer (euclidStep) y,
+    // cuando ambos caben en 64 bits, se termina con el algoritmo binario. Todas las reducciones
+    // son transformaciones unimodulares de (a, b), que conservan el máximo común divisor
+    BigUnsigned gcd(const BigUnsigned& other) const {
+        BigUnsigned a(*this), b(other);
+        if(a < b)
+            std::swap(a.limbs, b.limbs);
+        unsigned long long wa, wb;
+        bool negative = false;
+        while(!b.isZero()) {
+            if(a.toWord(wa) && b.toWord(wb))
+                return fromWord(binaryGcd(wa, wb));
+            size_t n = std::max(a.limbs.size(), b.limbs.size());
+            if(n >= gcdThreshold && std::min(a.limbs.size(), b.limbs.size()) > n / 2 + HGCD_MARGIN)
+                halfGcd(a, b, nullptr, negative);
+            else
+                euclidStep(a, b, nullptr, negative);
+        }
+        return a;
+    }
+
+    // Potencia *this^exponent por elevación binaria de izquierda a derecha
+    // Para exponentes grandes se usa una ventana deslizante de hasta 3 bits: se precalculan las
+    // potencias impares x, x^3, ..., x^(2^k-1) y cada ventana cuesta un solo producto
+    // Con el límite MAX_POWER_BITS el exponente tiene como mucho 27 bits, por lo que una
+    // ventana de 4 bits nunca compensa sus 8 potencias precalculadas
+    BigUnsigned pow(const BigUnsigned& exponent) const {
+        BigUnsigned one("1");
+        if(exponent.isZero())
+            return one;
+        if(isZero() || *this == one)
+            return *this;
+        // Con base mayor que 1, un exponente de más de 64 bits no cabría en memoria
+        unsigned long long e;
+        if(!exponent.toWord(e))
+            throw BigNumberException();
+        // El resultado tiene al menos (bits(*this) - 1) * e bits, con bits(*this) acotado por
+        // abajo a partir del limb alto; si supera MAX_POWER_BITS se rechaza antes de calcularlo
+        unsigned long long baseBits = (limbs.size() - 1) * LIMB_BITS + bigdetail::floorLog2(limbs.back());
+        if(baseBits > 0 && e > MAX_POWER_BITS / baseBits)
+            throw BigNumberException();
+        int bits = 0;
+        while(bits < 64 && (e >> bits) != 0)
+            bits++;
+        int k = (bits <= 8) ? 1 : (bits <= 24) ? 2 : 3;
+        std::vector<BigUnsigned> oddPowers(size_t(1) << (k - 1));
+        oddPowers[0] = *this;
+        if(k > 1) {
+            BigUnsigned x2 = square();
+            for(size_t i = 1; i < oddPowers.size(); i++)
+                oddPowers[i] = oddPowers[i-1] * x2;
+        }
+        BigUnsigned result;
+        bool started = false;
+        int i = bits - 1;
+        while(i >= 0) {
+            if(!((e >> i) & 1)) {
+                result = result.square();
+                i--;
+                continue;
+            }
+            // Ventana [j, i] de como mucho k bits que termina en un bit a 1
+            int j = std::max(i - k + 1, 0);
+            while(!((e >> j) & 1))
+                j++;
+            unsigned long long window = (e >> j) & ((1ULL << (i - j + 1)) - 1);
+            if(started) {
+                for(int l = j; l <= i; l++)
+                    result = result.square();
+                result = result * oddPowers[window >> 1];
+            } else {
+                result = oddPowers[window >> 1];
+                started = true;
+            }
+            i = j - 1;
+        }
+        return result;
     }
 
     // Convierte el número a un entero de 64 bits
     unsigned long long to_decimal() const {
         unsigned long long result = 0, power = 1;
-        for(size_t i = 0; i < digits.size(); i++){
-            result += digits[i] * power;
-            power *= Base;
+        for(size_t i = 0; i < limbs.size(); i++){
+            result += limbs[i] * power;
+            power *= LIMB_BASE;
         }
         return result;
     }
 
     // Método auxiliar que devuelve la representación numérica como cadena sin sufijo
     std::string toString() const {
+        if(limbs.empty())
+            return "0";
         std::string s;
-        // Se recorre el vector de dígitos en orden inverso para formar la cadena
-        for (int i = digits.size()-1; i >= 0; i--)
-            s.push_back(digitToChar(digits[i]));
+        s.reserve(limbs.size() * LIMB_DIGITS);
+        char chunk[LIMB_DIGITS];
+        // Se recorre el vector de limbs en orden inverso; cada limb aporta LIMB_DIGITS dígitos
+        // salvo el más significativo, que se escribe sin ceros a la izquierda
+        for(int i = limbs.size()-1; i >= 0; i--){
+            limb_t value = limbs[i];
+            for(int k = LIMB_DIGITS-1; k >= 0; k--){
+                chunk[k] = digitToChar(value % Base);
+                value /= Base;
+            }
+            unsigned first = 0;
+            if(i == (int)limbs.size()-1)
+                while(chunk[first] == '0') first++;
+            s.append(chunk + first, LIMB_DIGITS - first);
+        }
         return s;
     }
 
-    // Métodos virtuales de BigNumber implementados utilizando conversiones
-    // Se utiliza dynamic_cast para detectar si 'other' es un BigInteger y, en ese caso,
-    // se convierte *this a BigInteger para operar con signo
-    virtual BigNumber<Base>& add(const BigNumber<Base>& other) const {
-        const BigInteger<Base>* pInt = dynamic_cast<const BigInteger<Base>*>(&other);
-        if(pInt != nullptr) {
-            // Se convierte *this a BigInteger usando el operador de conversión
-            BigInteger<Base> left = static_cast<BigInteger<Base>>( *this );
-            BigInteger<Base> result = left + *pInt;
-            BigInteger<Base>* pres = new BigInteger<Base>(result);
-            return *pres;
-        } else {
-            // En otro caso, se convierte 'other' a BigUnsigned
-            BigUnsigned<Base> otherConv = other;
-            BigUnsigned<Base>* res = new BigUnsigned<Base>( (*this) + otherConv );
-            return *res;
-        }
-    }
-    virtual BigNumber<Base>& subtract(const BigNumber<Base>& other) const {
-        const BigInteger<Base>* pInt = dynamic_cast<const BigInteger<Base>*>(&other);
-        if(pInt != nullptr) {
-            BigInteger<Base> left = static_cast<BigInteger<Base>>( *this );
-            BigInteger<Base> result = left - *pInt;
-            BigInteger<Base>* pres = new BigInteger<Base>(result);
-            return *pres;
-        } else {
-            BigUnsigned<Base> otherConv = other;
-            BigUnsigned<Base>* res = new BigUnsigned<Base>( (*this) - otherConv );
-            return *res;
-        }
-    }
-    virtual BigNumber<Base>& multiply(const BigNumber<Base>& other) const {
-        const BigInteger<Base>* pInt = dynamic_cast<const BigInteger<Base>*>(&other);
-        if(pInt != nullptr) {
-            BigInteger<Base> left = static_cast<BigInteger<Base>>( *this );
-            BigInteger<Base> result = left * *pInt;
-            BigInteger<Base>* pres = new BigInteger<Base>(result);
-            return *pres;
-        } else {
-            BigUnsigned<Base> otherConv = other;
-            BigUnsigned<Base>* res = new BigUnsigned<Base>( (*this) * otherConv );
-            return *res;
-        }
-    }
-    virtual BigNumber<Base>& divide(const BigNumber<Base>& other) const {
-        const BigInteger<Base>* pInt = dynamic_cast<const BigInteger<Base>*>(&other);
-        if(pInt != nullptr) {
-            BigInteger<Base> left = static_cast<BigInteger<Base>>( *this );
-            BigInteger<Base> result = left / *pInt;
-            BigInteger<Base>* pres = new BigInteger<Base>(result);
-            return *pres;
-        } else {
-            BigUnsigned<Base> otherConv = other;
-            BigUnsigned<Base>* res = new BigUnsigned<Base>( (*this) / otherConv );
-            return *res;
-        }
+    // Métodos virtuales de BigNumber
+    // La suma, resta, multiplicación, división y módulo los resuelve la tabla de BigNumber
+    virtual typename BigNumber<Base>::Kind kind() const {
+        return BigNumber<Base>::UNSIGNED;
+    }
+    // La potencia conserva el tipo de la base; un exponente negativo no tiene resultado natural
+    virtual std::unique_ptr<BigNumber<Base>> power(const BigNumber<Base>& other) const {
+        bool negative;
+        BigUnsigned<Base> exponent = BigNumber<Base>::exponentOf(other, negative);
+        if(negative)
+            throw BigNumberException();
+        return BigNumber<Base>::makeOwned(pow(exponent));
     }
 
     // Operadores de conversión virtuales
@@ -248,10 +1778,47 @@ public:
 
     // Operador de igualdad, usado para la división
     bool operator==(const BigUnsigned& other) const {
-        return digits == other.digits;
+        return limbs == other.limbs;
     }
+
+    // La conversión entre bases lee directamente los limbs de las otras instancias
+    template <unsigned char> friend class BigUnsigned;
 };
 
+// Definiciones de los miembros estáticos constantes (necesarias en C++11 si se usan por referencia)
+template <unsigned char Base>
+constexpr unsigned BigUnsigned<Base>::LIMB_DIGITS;
+template <unsigned char Base>
+constexpr typename BigUnsigned<Base>::limb_t BigUnsigned<Base>::LIMB_BASE;
+template <unsigned char Base>
+constexpr unsigned BigUnsigned<Base>::LIMB_BITS;
+// Con limbs de 28 bits (base 16) un bloque entero de la multiplicación clásica se acumula sin
+// normalizar, y Karatsuba tarda más en compensar: el cruce está en 64 limbs frente a 48
+template <unsigned char Base>
+size_t BigUnsigned<Base>::karatsubaThreshold = (MUL_FOLD_ROWS >= MUL_TILE) ? 64 : 48;
+template <unsigned char Base>
+size_t BigUnsigned<Base>::toomThreshold = 768;
+template <unsigned char Base>
+size_t BigUnsigned<Base>::nttThreshold = 6000;
+template <unsigned char Base>
+size_t BigUnsigned<Base>::bzThreshold = 60;
+template <unsigned char Base>
+size_t BigUnsigned<Base>::gcdThreshold = 64;
+template <unsigned char Base>
+const size_t BigUnsigned<Base>::HGCD_MARGIN;
+template <unsigned char Base>
+const size_t BigUnsigned<Base>::NTT_MAX_LENGTH;
+template <unsigned char Base>
+constexpr typename BigUnsigned<Base>::limb_t BigUnsigned<Base>::NTT_PRIME0;
+template <unsigned char Base>
+constexpr typename BigUnsigned<Base>::limb_t BigUnsigned<Base>::NTT_PRIME1;
+template <unsigned char Base>
+constexpr typename BigUnsigned<Base>::limb_t BigUnsigned<Base>::NTT_PRIME2;
+template <unsigned char Base>
+const unsigned long long BigUnsigned<Base>::MAX_POWER_BITS;
+template <unsigned char Base>
+const size_t BigUnsigned<Base>::RADIX_THRESHOLD;
+
 // Implementación de la conversión de BigUnsigned a BigInteger
 // Se llama al constructor de BigInteger que recibe un BigUnsigned
 template <unsigned char Base>
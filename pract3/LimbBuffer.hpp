@@ -0,0 +1,162 @@
+#ifndef LIMBBUFFER_HPP
+#define LIMBBUFFER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+// Daniel Palenzuela Álvarez alu0101140469
+
+// Almacén contiguo de limbs con las operaciones de std::vector que usa BigUnsigned
+// Los primeros N elementos se guardan dentro del propio objeto, de modo que los números
+// cortos no reservan memoria dinámica; solo al superar esa capacidad se pasa al montículo.
+// T debe ser un tipo trivial (los limbs son enteros sin signo)
+template <typename T, size_t N>
+class LimbBuffer {
+private:
+    T* ptr;        // Apunta a local o a la memoria dinámica
+    size_t len;
+    size_t cap;
+    T local[N];
+
+    bool isLocal() const {
+        return ptr == local;
+    }
+
+    // Garantiza capacidad para n elementos conservando los actuales
+    void grow(size_t n) {
+        if(n <= cap)
+            return;
+        size_t newCap = std::max(n, 2 * cap);
+        T* fresh = new T[newCap];
+        std::memcpy(fresh, ptr, len * sizeof(T));
+        if(!isLocal())
+            delete[] ptr;
+        ptr = fresh;
+        cap = newCap;
+    }
+
+    // Toma el contenido de other y lo deja vacío (other no se usa después sin reasignar)
+    void steal(LimbBuffer& other) {
+        if(other.isLocal()) {
+            ptr = local;
+            cap = N;
+            std::memcpy(local, other.local, other.len * sizeof(T));
+        } else {
+            ptr = other.ptr;
+            cap = other.cap;
+            other.ptr = other.local;
+            other.cap = N;
+        }
+        len = other.len;
+        other.len = 0;
+    }
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    LimbBuffer() : ptr(local), len(0), cap(N) {}
+
+    explicit LimbBuffer(size_t n, T value = T()) : ptr(local), len(0), cap(N) {
+        assign(n, value);
+    }
+
+    LimbBuffer(const T* first, const T* last) : ptr(local), len(0), cap(N) {
+        assign(first, last);
+    }
+
+    LimbBuffer(const LimbBuffer& other) : ptr(local), len(0), cap(N) {
+        assign(other.begin(), other.end());
+    }
+
+    LimbBuffer(LimbBuffer&& other) noexcept {
+        steal(other);
+    }
+
+    ~LimbBuffer() {
+        if(!isLocal())
+            delete[] ptr;
+    }
+
+    LimbBuffer& operator=(const LimbBuffer& other) {
+        if(this != &other)
+            assign(other.begin(), other.end());
+        return *this;
+    }
+
+    LimbBuffer& operator=(LimbBuffer&& other) noexcept {
+        if(this != &other) {
+            if(!isLocal())
+                delete[] ptr;
+            steal(other);
+        }
+        return *this;
+    }
+
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    T* data() { return ptr; }
+    const T* data() const { return ptr; }
+    T* begin() { return ptr; }
+    const T* begin() const { return ptr; }
+    T* end() { return ptr + len; }
+    const T* end() const { return ptr + len; }
+    T& operator[](size_t i) { return ptr[i]; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    T& back() { return ptr[len-1]; }
+    const T& back() const { return ptr[len-1]; }
+
+    void reserve(size_t n) {
+        grow(n);
+    }
+
+    // Los elementos nuevos se inicializan a value
+    void resize(size_t n, T value = T()) {
+        grow(n);
+        if(n > len)
+            std::fill(ptr + len, ptr + n, value);
+        len = n;
+    }
+
+    void assign(size_t n, T value) {
+        len = 0;
+        resize(n, value);
+    }
+
+    // [first, last) no puede solapar con el propio buffer
+    void assign(const T* first, const T* last) {
+        len = 0;
+        append(first, last);
+    }
+
+    void append(const T* first, const T* last) {
+        size_t n = last - first;
+        grow(len + n);
+        if(n > 0)
+            std::memcpy(ptr + len, first, n * sizeof(T));
+        len += n;
+    }
+
+    void push_back(T value) {
+        grow(len + 1);
+        ptr[len++] = value;
+    }
+
+    void pop_back() {
+        len--;
+    }
+
+    void swap(LimbBuffer& other) {
+        LimbBuffer tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    bool operator==(const LimbBuffer& other) const {
+        return len == other.len && std::memcmp(ptr, other.ptr, len * sizeof(T)) == 0;
+    }
+};
+
+#endif
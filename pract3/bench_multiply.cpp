@@ -0,0 +1,129 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "BigNumber.hpp"
+
+// Daniel Palenzuela Álvarez alu0101140469
+
+// Medida de los puntos de cruce entre los niveles de la multiplicación en las bases 8, 10 y 16
+// Para cada tamaño n (en limbs) se compara el nivel inferior con un solo nivel del superior:
+// con el umbral del nivel superior igual a n, el producto de n limbs usa ese algoritmo y sus
+// subproductos, más pequeños, vuelven al nivel inferior. El cruce es el primer tamaño a partir
+// del cual el nivel superior gana en todos los tamaños medidos, y es el valor que conviene
+// dar al umbral por defecto (karatsubaThreshold, toomThreshold y nttThreshold)
+// Los niveles que no se comparan usan los umbrales por defecto de la base
+
+// Umbral que desactiva un nivel
+const size_t OFF = 100000000;
+
+// Dígitos de la base por limb, con la misma regla que BigUnsigned (Base^k <= 2^30)
+unsigned digitsPerLimb(unsigned base) {
+    unsigned k = 0;
+    unsigned long long power = 1;
+    while(power * base <= (1ULL << 30)) {
+        power *= base;
+        k++;
+    }
+    return k;
+}
+
+// Número aleatorio de exactamente n limbs
+template <unsigned char Base>
+BigUnsigned<Base> randomNumber(std::mt19937& gen, size_t limbs) {
+    const char* digits = "0123456789ABCDEF";
+    std::string s;
+    s.push_back(digits[1 + gen() % (Base - 1)]);
+    for(size_t i = 1; i < limbs * digitsPerLimb(Base); i++)
+        s.push_back(digits[gen() % Base]);
+    return BigUnsigned<Base>(s.c_str());
+}
+
+// Umbrales de Karatsuba, Toom-3 y NTT
+struct Thresholds {
+    size_t karatsuba, toom, ntt;
+};
+
+// Umbrales por defecto de la base
+template <unsigned char Base>
+Thresholds defaultThresholds() {
+    Thresholds t;
+    BigUnsigned<Base>::getMultiplyThresholds(t.karatsuba, t.toom, t.ntt);
+    return t;
+}
+
+// Tiempo medio (en microsegundos) de x*y con los umbrales dados
+// Repite el producto hasta acumular al menos 10 ms
+template <unsigned char Base>
+double timeProduct(const BigUnsigned<Base>& x, const BigUnsigned<Base>& y, Thresholds t) {
+    typedef std::chrono::steady_clock Clock;
+    BigUnsigned<Base>::setMultiplyThresholds(t.karatsuba, t.toom, t.ntt);
+    size_t reps = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        BigUnsigned<Base> product = x * y;
+        reps++;
+        elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    } while(elapsed < 10000);
+    return elapsed / reps;
+}
+
+// Mide un par de niveles en los tamaños dados e imprime la tabla y el cruce estimado
+// lower(n) y upper(n) devuelven los umbrales de cada nivel para un producto de n limbs
+template <unsigned char Base, class Lower, class Upper>
+void crossover(const char* lowerName, const char* upperName, const std::vector<size_t>& sizes,
+               Lower lower, Upper upper) {
+    std::mt19937 gen(Base);
+    std::cout << "Base " << (int)Base << ": " << lowerName << " frente a " << upperName << "\n";
+    std::cout << std::setw(8) << "limbs" << std::setw(14) << lowerName << std::setw(14) << upperName
+              << "   (us)\n";
+    size_t cross = 0;
+    for(size_t n : sizes) {
+        BigUnsigned<Base> x = randomNumber<Base>(gen, n), y = randomNumber<Base>(gen, n);
+        // Las medidas de los dos niveles se alternan y se toma la mejor de cinco de cada uno,
+        // para que una racha de ruido no afecte solo a uno de ellos
+        double tLower = 1e300, tUpper = 1e300;
+        for(int round = 0; round < 5; round++) {
+            tLower = std::min(tLower, timeProduct(x, y, lower(n)));
+            tUpper = std::min(tUpper, timeProduct(x, y, upper(n)));
+        }
+        std::cout << std::setw(8) << n << std::fixed << std::setprecision(2)
+                  << std::setw(14) << tLower << std::setw(14) << tUpper << "\n";
+        if(tUpper >= tLower)
+            cross = 0;
+        else if(cross == 0)
+            cross = n;
+    }
+    if(cross != 0)
+        std::cout << "Cruce estimado: " << cross << " limbs\n\n";
+    else
+        std::cout << "Sin cruce en los tamaños medidos\n\n";
+}
+
+template <unsigned char Base>
+void benchBase() {
+    const Thresholds d = defaultThresholds<Base>();
+    std::cout << "Base " << (int)Base << ": umbrales por defecto " << d.karatsuba << ", "
+              << d.toom << ", " << d.ntt << "\n\n";
+    crossover<Base>("clásica", "Karatsuba", {4, 6, 8, 12, 16, 20, 24, 32, 40, 48, 64, 96, 128},
+        [](size_t) { return Thresholds{OFF, OFF, OFF}; },
+        [](size_t n) { return Thresholds{n, OFF, OFF}; });
+    crossover<Base>("Karatsuba", "Toom-3", {256, 384, 512, 640, 768, 1024, 1536, 2048},
+        [d](size_t) { return Thresholds{d.karatsuba, OFF, OFF}; },
+        [d](size_t n) { return Thresholds{d.karatsuba, n, OFF}; });
+    crossover<Base>("Toom-3", "NTT", {2000, 3000, 4000, 5000, 6000, 8000, 12000},
+        [d](size_t) { return Thresholds{d.karatsuba, d.toom, OFF}; },
+        [d](size_t n) { return Thresholds{d.karatsuba, d.toom, n}; });
+    // Se restauran los umbrales por defecto
+    BigUnsigned<Base>::setMultiplyThresholds(d.karatsuba, d.toom, d.ntt);
+}
+
+int main() {
+    benchBase<8>();
+    benchBase<10>();
+    benchBase<16>();
+    return 0;
+}
@@ -3,40 +3,59 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include <memory>
+#include <cstdlib>
 #include "BigNumber.hpp"
 
 // Daniel Palenzuela Álvarez alu0101140469
 
 // Se utiliza para almacenar los operandos (etiqueta, puntero a BigNumber)
 // y mantener el orden de inserción (como se leeron del fichero)
+// Los valores se comparten con la pila del evaluador mediante shared_ptr: cada objeto se
+// libera en cuanto ni el board ni la pila lo referencian
 template <unsigned char Base>
 class Board {
 public:
+    typedef std::shared_ptr<BigNumber<Base>> Value;
+
     // Vector de pares, la primera parte es la etiqueta y la segunda es el puntero al objeto
-    std::vector<std::pair<std::string, BigNumber<Base>*>> entries;
+    std::vector<std::pair<std::string, Value>> entries;
 
     // Busca un objeto en el board por su etiqueta y devuelve nullptr si no lo encuentra
-    BigNumber<Base>* lookup(const std::string& label) const {
+    Value lookup(const std::string& label) const {
         for(const auto& p : entries)
             if(p.first == label)
                 return p.second;
         return nullptr;
     }
 
-    // Inserta o actualiza una entrada en el board
-    void insert(const std::string& label, BigNumber<Base>* num) {
+    // Inserta o actualiza una entrada en el board (el valor anterior se libera si nadie lo usa)
+    void insert(const std::string& label, Value num) {
         for(auto& p : entries) {
             if(p.first == label) {
-                p.second = num;
+                p.second = std::move(num);
                 return;
             }
         }
-        entries.push_back({label, num});
+        entries.push_back({label, std::move(num)});
     }
 };
 
+// Escribe las entradas del board en el orden en que se insertaron, expresadas en la base Out
+template <unsigned char Base, unsigned char Out>
+void writeBoard(std::ostream& out, const Board<Base>& board) {
+    for(const auto& p : board.entries) {
+        if(Out == Base)
+            out << p.first << " = " << *p.second << "\n";
+        else
+            out << p.first << " = " << *p.second->template toBase<Out>() << "\n";
+    }
+}
+
+// outputBase es la base en la que se escribe el board (0 para la misma base de la entrada)
 template <unsigned char Base>
-void processFile(const std::string& inputFilename, const std::string& outputFilename) {
+void processFile(const std::string& inputFilename, const std::string& outputFilename,
+                 unsigned outputBase) {
     // Abrir ficheros de entrada y salida
     std::ifstream infile(inputFilename);
     std::ofstream outfile(outputFilename);
@@ -47,7 +66,11 @@ void processFile(const std::string& inputFilename, const std::string& outputFile
     std::string line;
     // Leer la primera línea, que contiene la base, por ejemplo "Base = 16"
     std::getline(infile, line);
-    outfile << line << "\n";  // Escribir la base en la salida
+    // Escribir la base en la salida
+    if(outputBase == 0 || outputBase == Base)
+        outfile << line << "\n";
+    else
+        outfile << "Base = " << outputBase << "\n";
 
     // Crear el board para almacenar los operandos
     Board<Base> board;
@@ -66,8 +89,7 @@ void processFile(const std::string& inputFilename, const std::string& outputFile
             iss >> value;
             try {
                 // Crear el objeto usando el método de fábrica de BigNumber
-                BigNumber<Base>* bn = BigNumber<Base>::create(value.c_str());
-                board.insert(label, bn);
+                board.insert(label, BigNumber<Base>::create(value.c_str()));
             } catch(const BigNumberException& e) {
                 std::cerr << "Error en la línea: " << line << "\n" << e.what() << "\n";
                 board.insert(label, BigNumber<Base>::create("0u"));
@@ -80,35 +102,40 @@ void processFile(const std::string& inputFilename, const std::string& outputFile
             while(iss >> token)
                 tokens.push_back(token);
             // Evaluar la expresión usando una pila
-            std::vector<BigNumber<Base>*> stack;
+            // Los resultados intermedios se liberan al desapilarlos o si se produce un error
+            std::vector<typename Board<Base>::Value> stack;
             try {
                 // Procesar cada token
                 for(const auto& t : tokens) {
                     // Si el token es un operador aritmético
-                    if(t == "+" || t == "-" || t == "*" || t == "/") {
+                    if(t == "+" || t == "-" || t == "*" || t == "/" || t == "%" || t == "^") {
                         if(stack.size() < 2)
                             throw BigNumberException();
                         // Se extraen los dos operandos
-                        BigNumber<Base>* b = stack.back(); stack.pop_back();
-                        BigNumber<Base>* a = stack.back(); stack.pop_back();
-                        BigNumber<Base>* res = nullptr;
+                        typename Board<Base>::Value b = std::move(stack.back()); stack.pop_back();
+                        typename Board<Base>::Value a = std::move(stack.back()); stack.pop_back();
+                        std::unique_ptr<BigNumber<Base>> res;
                         // Se llama al método virtual adecuado
                         if(t == "+")
-                            res = &a->add(*b);
+                            res = a->add(*b);
                         else if(t == "-")
-                            res = &a->subtract(*b);
+                            res = a->subtract(*b);
                         else if(t == "*")
-                            res = &a->multiply(*b);
+                            res = a->multiply(*b);
                         else if(t == "/")
-                            res = &a->divide(*b);
+                            res = a->divide(*b);
+                        else if(t == "%")
+                            res = a->modulo(*b);
+                        else if(t == "^")
+                            res = a->power(*b);
                         // Se empuja el resultado en la pila
-                        stack.push_back(res);
+                        stack.push_back(std::move(res));
                     } else {
                         // Si el token es una etiqueta, se busca en el board
-                        BigNumber<Base>* p = board.lookup(t);
+                        typename Board<Base>::Value p = board.lookup(t);
                         if(p == nullptr)
                             throw BigNumberException();
-                        stack.push_back(p);
+                        stack.push_back(std::move(p));
                     }
                 }
                 if(stack.size() != 1)
@@ -122,21 +149,42 @@ void processFile(const std::string& inputFilename, const std::string& outputFile
             }
         }
     }
-    // Escribir el contenido del board en el fichero de salida en el orden en que se insertaron
-    for(const auto& p : board.entries) {
-        outfile << p.first << " = " << *p.second << "\n";
+    // Escribir el contenido del board en el fichero de salida, convertido a la base pedida
+    switch(outputBase) {
+        case 8:
+            writeBoard<Base, 8>(outfile, board);
+            break;
+        case 10:
+            writeBoard<Base, 10>(outfile, board);
+            break;
+        case 16:
+            writeBoard<Base, 16>(outfile, board);
+            break;
+        default:
+            writeBoard<Base, Base>(outfile, board);
+            break;
     }
 }
 
 int main(int argc, char* argv[]) {
     // Verificar que se pasaron los parámetros de entrada y salida
     if(argc < 3) {
-        std::cerr << "Uso: calculator <fichero_entrada> <fichero_salida>\n";
+        std::cerr << "Uso: calculator <fichero_entrada> <fichero_salida> [base_salida]\n";
         return 1;
     }
     std::string inputFilename = argv[1];
     std::string outputFilename = argv[2];
 
+    // Base opcional en la que se escribe el resultado (por defecto la del fichero de entrada)
+    unsigned outputBase = 0;
+    if(argc > 3) {
+        outputBase = std::atoi(argv[3]);
+        if(outputBase != 8 && outputBase != 10 && outputBase != 16) {
+            std::cerr << "Base de salida no soportada: " << argv[3] << "\n";
+            return 1;
+        }
+    }
+
     // Abrir el fichero de entrada para leer la primera línea (la base)
     std::ifstream infile(inputFilename);
     if(!infile.is_open()){
@@ -157,13 +205,13 @@ int main(int argc, char* argv[]) {
     // Instanciar la función plantilla processFile según la base leída
     switch(baseValue) {
         case 8:
-            processFile<8>(inputFilename, outputFilename);
+            processFile<8>(inputFilename, outputFilename, outputBase);
             break;
         case 10:
-            processFile<10>(inputFilename, outputFilename);
+            processFile<10>(inputFilename, outputFilename, outputBase);
             break;
         case 16:
-            processFile<16>(inputFilename, outputFilename);
+            processFile<16>(inputFilename, outputFilename, outputBase);
             break;
         default:
             std::cerr << "Base no soportada: " << baseValue << "\n";
@@ -185,24 +233,23 @@ void compareAndSubtract(const BigNumber<Base>& num1, const BigNumber<Base>& num2
     BigInteger<Base> a = num1;
     BigInteger<Base> b = num2;
 
-    // Obtener el valor decimal de cada número mediante el método to_decimal().
-    // Este valor se utiliza para realizar la comparación.
-    unsigned long long decA = a.to_decimal();
-    unsigned long long decB = b.to_decimal();
+    // Comparar los valores con signo sobre los números completos (to_decimal() desbordaría
+    // con más de 64 bits y no tiene en cuenta el signo)
+    int cmp = a.compare(b);
 
     // Imprimir ambos números
     std::cout << "Número 1: " << a << std::endl;
     std::cout << "Número 2: " << b << std::endl;
 
-    // Comparar los valores decimales para determinar cuál es menor y cuál mayor
-    if (decA < decB) {
+    // Determinar cuál es menor y cuál mayor
+    if (cmp < 0) {
         // Si a es menor que b
         std::cout << "El menor es: " << a << std::endl;
         std::cout << "El mayor es: " << b << std::endl;
         // Calcular la diferencia: mayor - menor
         BigInteger<Base> diff = b - a;
         std::cout << "Resta (mayor - menor): " << diff << std::endl;
-    } else if (decB < decA) {
+    } else if (cmp > 0) {
         // Si b es menor que a
         std::cout << "El menor es: " << b << std::endl;
         std::cout << "El mayor es: " << a << std::endl;
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include "BigNumber.hpp"
+
+// Daniel Palenzuela Álvarez alu0101140469
+
+// Prueba de los niveles de Toom-Cook de la multiplicación
+// Con umbrales muy bajos (Karatsuba desde 2 limbs y Toom-3 desde 3) y sin NTT, todo producto
+// de operandos de varios limbs pasa por Toom-3 (operandos equilibrados o cuadrados) o por
+// Toom-2.5 (el menor entre la mitad y dos tercios del mayor), tanto en el nivel superior como
+// en las llamadas recursivas. El resultado se compara con el de la multiplicación clásica,
+// que se fuerza subiendo todos los umbrales
+
+// Genera una cadena de n dígitos de la base: aleatorios o todos iguales a Base-1, que es el
+// caso que produce más acarreos en las evaluaciones e interpolaciones
+template <unsigned char Base>
+std::string randomDigits(std::mt19937& gen, size_t n, bool allMax) {
+    const char* digits = "0123456789ABCDEF";
+    std::string s;
+    s.push_back(digits[allMax ? Base - 1 : 1 + gen() % (Base - 1)]);
+    for(size_t i = 1; i < n; i++)
+        s.push_back(digits[allMax ? Base - 1 : gen() % Base]);
+    return s;
+}
+
+// Multiplica x por y con la multiplicación clásica y con los niveles de Toom-Cook
+// Devuelve false (e informa del caso) si los resultados no coinciden
+template <unsigned char Base>
+bool checkProduct(const std::string& a, const std::string& b, const char* tier) {
+    BigUnsigned<Base> x(a.c_str()), y(b.c_str());
+    BigUnsigned<Base>::setMultiplyThresholds(1000000, 1000000, 1000000);
+    BigUnsigned<Base> expected = x * y;
+    BigUnsigned<Base> expectedSquare = x * x;
+    BigUnsigned<Base>::setMultiplyThresholds(2, 3, 1000000);
+    BigUnsigned<Base> product = x * y;
+    BigUnsigned<Base> square = x * x;
+    bool ok = (product == expected) && (square == expectedSquare);
+    if(!ok)
+        std::cerr << "Fallo en base " << (int)Base << " (" << tier << "): " << a.size()
+                  << " x " << b.size() << " dígitos\n";
+    return ok;
+}
+
+// Recorre operandos equilibrados (Toom-3), con proporción 3:2 (Toom-2.5) y muy desiguales
+// (troceados en bloques que vuelven a pasar por Toom), aleatorios y con todos los dígitos
+// a Base-1. Devuelve el número de fallos
+template <unsigned char Base>
+int testBase() {
+    std::mt19937 gen(Base);
+    // Umbrales por defecto, que se restauran al terminar
+    size_t karatsuba, toom, ntt;
+    BigUnsigned<Base>::getMultiplyThresholds(karatsuba, toom, ntt);
+    int failures = 0, cases = 0;
+    for(size_t n = 20; n <= 2500; n = n * 3 / 2) {
+        for(int allMax = 0; allMax < 2; allMax++) {
+            std::string a = randomDigits<Base>(gen, n, allMax);
+            std::string balanced = randomDigits<Base>(gen, n - gen() % (n / 4 + 1), allMax);
+            std::string twoThirds = randomDigits<Base>(gen, n * 3 / 5 + gen() % (n / 20 + 1), allMax);
+            std::string small = randomDigits<Base>(gen, n / 5 + 1, allMax);
+            failures += !checkProduct<Base>(a, balanced, "Toom-3");
+            failures += !checkProduct<Base>(a, twoThirds, "Toom-2.5");
+            failures += !checkProduct<Base>(a, small, "desigual");
+            cases += 3;
+        }
+    }
+    // Se restauran los umbrales por defecto
+    BigUnsigned<Base>::setMultiplyThresholds(karatsuba, toom, ntt);
+    std::cout << "Base " << (int)Base << ": " << cases - failures << "/" << cases
+              << " productos correctos\n";
+    return failures;
+}
+
+int main() {
+    int failures = testBase<8>() + testBase<10>() + testBase<16>();
+    return failures == 0 ? 0 : 1;
+}